@@ -49,13 +49,25 @@ bool barrackEventServerOnDisconnect (
 ) {
     /// TODO : Redirect the query to Worker with a internal packet
 
-    // Get the current game session
+    // Get the current game session and flush the Redis session of the client at once
     GameSession gameSession;
-    if (!(redisGetGameSessionBySocketId(redis, routerId, sessionKeyStr, &gameSession))) {
-        error("Cannot get game session of '%s'", sessionKeyStr);
+    bool found;
+    RedisSessionKey sessionKey = {
+        .socketKey = {
+            .routerId = routerId,
+            .sessionKey = sessionKeyStr
+        }
+    };
+    if (!(redisGetAndFlushSession(redis, &sessionKey, &gameSession, &found))) {
+        error("Cannot get and flush the game session of '%s'", sessionKeyStr);
         return false;
     }
 
+    if (!found) {
+        // The game session has been moved to a zone server, that owns it now
+        return true;
+    }
+
     // Transfer the Redis session to SQL
     if (!(mySqlCommanderSessionFlush(mysql, &gameSession.commanderSession))) {
         error ("Cannot flush the redis session '%s' to the SQL.", sessionKeyStr);
@@ -63,17 +75,5 @@ bool barrackEventServerOnDisconnect (
         // TODO : Should we flush the Redis data in that case ?
     }
 
-    // Flush the Redis session of the client
-    RedisSessionKey sessionKey = {
-        .socketKey = {
-            .routerId = routerId,
-            .sessionKey = sessionKeyStr
-        }
-    };
-    if (!(redisFlushSession (redis, &sessionKey))) {
-        error ("Cannot flush the redis session '%s'", sessionKey);
-        return false;
-    }
-
     return true;
 }
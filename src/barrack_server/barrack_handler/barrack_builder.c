@@ -34,7 +34,7 @@ void barrackBuilderMessage(uint8_t msgType, uint8_t *message, zmsg_t *replyMsg)
     #pragma pack(pop)
 
     PacketType packetType = BC_MESSAGE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, BC_MESSAGE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -64,7 +64,7 @@ void barrackBuilderLoginOk(
     #pragma pack(pop)
 
     PacketType packetType = BC_LOGINOK;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, BC_LOGINOK);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -102,7 +102,7 @@ void barrackBuilderStartGameOk(
     #pragma pack(pop)
 
     PacketType packetType = BC_START_GAMEOK;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, BC_START_GAMEOK);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -173,7 +173,7 @@ void barrackBuilderIesModifyList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     // PacketType packetType = BC_IES_MODIFY_LIST;
-    // CHECK_SERVER_PACKET_SIZE (replyPacket, packetType);
+    // CHECK_SERVER_PACKET_SIZE (replyPacket, BC_IES_MODIFY_LIST);
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
         /*
@@ -203,7 +203,7 @@ void barrackBuilderIesModifyList(zmsg_t *replyMsg) {
             , NULL, &memSize
         );
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, memory, memSize);
         */
     }
 }
@@ -226,7 +226,7 @@ void barrackBuilderServerEntry(
     #pragma pack(pop)
 
     PacketType packetType = BC_SERVER_ENTRY;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, BC_SERVER_ENTRY);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -330,32 +330,32 @@ void barrackBuilderCommanderList(
     DEFINE_BarrackBuilderCommanderListCPacket(commanderBarrackInfoPacketSize);
     #pragma pack(pop)
 
-    BarrackBuilderCommanderListCPacket replyPacket;
+    BarrackBuilderCommanderListCPacket *replyPacket;
 
-    PacketStream packetStream;
-    packetStreamInit(&packetStream, &replyPacket, sizeof(replyPacket));
-
-    // Now fill it
+    // Now fill it, directly in the reply
     PacketType packetType = BC_COMMANDER_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, BC_COMMANDER_LIST);
+
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
+    {
+        PacketStream packetStream;
+        packetStreamInit(&packetStream, replyPacket, sizeof(*replyPacket));
 
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
-    {
         // Fill replyPacket
-        variableSizePacketHeaderInit(&replyPacket.variableSizeHeader, packetType, sizeof(replyPacket));
-        replyPacket.accountId = accountId;
-        replyPacket.unk1 = 0; // ICBT - equal to 1 or 4
-        replyPacket.unk2 = 0; // ?
-        replyPacket.commandersCount = commandersCount;
-        strncpy(replyPacket.familyName, gameSession->accountSession.familyName, sizeof(replyPacket.familyName));
+        variableSizePacketHeaderInit(&replyPacket->variableSizeHeader, packetType, sizeof(*replyPacket));
+        replyPacket->accountId = accountId;
+        replyPacket->unk1 = 0; // ICBT - equal to 1 or 4
+        replyPacket->unk2 = 0; // ?
+        replyPacket->commandersCount = commandersCount;
+        strncpy(replyPacket->familyName, gameSession->accountSession.familyName, sizeof(replyPacket->familyName));
 
-        replyPacket.accountInfoBytesLength = 0x12; // 3 sets
-        replyPacket.typeCredits = SWAP_UINT16(0x9c18); // 94 0E = Medal (iCoin)
-        replyPacket.creditsAmount = gameSession->accountSession.credits;
-        replyPacket.typeCredits2 = SWAP_UINT16(0x9e18); // 94 0E = Medal (iCoin)
-        replyPacket.creditsAmount2 = 0;
-        replyPacket.typeCredits3 = SWAP_UINT16(0xa018); // 94 0E = Medal (iCoin)
-        replyPacket.creditsAmount3 = 0;
+        replyPacket->accountInfoBytesLength = 0x12; // 3 sets
+        replyPacket->typeCredits = SWAP_UINT16(0x9c18); // 94 0E = Medal (iCoin)
+        replyPacket->creditsAmount = gameSession->accountSession.credits;
+        replyPacket->typeCredits2 = SWAP_UINT16(0x9e18); // 94 0E = Medal (iCoin)
+        replyPacket->creditsAmount2 = 0;
+        replyPacket->typeCredits3 = SWAP_UINT16(0xa018); // 94 0E = Medal (iCoin)
+        replyPacket->creditsAmount3 = 0;
 
         // we want to start writing at the offset of commandersBarrackInfoPacket
         if (commanderBarrackInfoPacketSize > 0) {
@@ -431,9 +431,9 @@ void barrackBuilderCommanderList(
             packetStreamAddOffset(&packetStream, sizeof_struct_member(CommanderBarrackInfoCPacket, unk9));
             packetStreamAddOffset(&packetStream, sizeof_struct_member(CommanderBarrackInfoCPacket, jobId));
         }
+
+        buffer_print(replyPacket, sizeof(*replyPacket), NULL);
     }
-
-    buffer_print(&replyPacket, sizeof(replyPacket), NULL);
 }
 
 void barrackBuilderPetInformation(zmsg_t *replyMsg) {
@@ -496,20 +496,12 @@ void barrackBuilderZoneTraffics(MapId_t mapId, zmsg_t *replyMsg) {
     // number of players per zone
     int currentPlayersCount = 10;
 
-    // count the total memory space needed for the reply packet
-    size_t outPacketSize = sizeof(ZoneTrafficsPacket) + (sizeof(SingleMapTraffic) * mapAvailableCount);
-
-    for (int mapIndex = 0; mapIndex < mapAvailableCount; mapIndex++) {
-        outPacketSize += sizeof(SingleZoneTraffic) * zoneServerCounts[mapIndex];
-    }
-
-    // allocate on the stack the memory for the packet
-    uint8_t *stackBuffer = alloca(sizeof(*stackBuffer) * outPacketSize);
-    memset(stackBuffer, 0, outPacketSize);
-
-    // construct the packet
+    // construct the packet, the stream grows with it
     PacketStream stream;
-    packetStreamInit(&stream, (uint8_t *)stackBuffer, outPacketSize);
+    if (!(packetStreamInitGrowable(&stream, 0))) {
+        error("Cannot initialize the zone traffics stream.");
+        return;
+    }
 
     packetStreamAppend(&stream, &zoneMaxPcCount, sizeof_struct_member(ZoneTrafficsPacket, zoneMaxPcCount));
     packetStreamAppend(&stream, &mapAvailableCount, sizeof_struct_member(ZoneTrafficsPacket, mapAvailableCount));
@@ -524,19 +516,48 @@ void barrackBuilderZoneTraffics(MapId_t mapId, zmsg_t *replyMsg) {
         }
     }
 
-    // compress the packet
+    if (packetStreamHasError(&stream)) {
+        error("Cannot write the zone traffics.");
+        packetStreamFree(&stream);
+        return;
+    }
+
+    uint8_t *trafficsData = packetStreamGetBuffer(&stream);
+    size_t outPacketSize = packetStreamGetSize(&stream);
+
+    // compress the packet directly in the reply
 	#pragma pack(push, 1)
     struct {
         PacketNormalHeader normalHeader;
         Zlib zlibData;
-    } compressedPacket;
+    } *compressedPacket;
     #pragma pack(pop)
 
-    zlibCompress(&compressedPacket.zlibData, stackBuffer, outPacketSize);
-    outPacketSize = ZLIB_GET_COMPRESSED_PACKET_SIZE(&compressedPacket.zlibData, sizeof(compressedPacket));
-    packetNormalHeaderInit(&compressedPacket.normalHeader, BC_NORMAL_ZONE_TRAFFIC, outPacketSize);
+    size_t compressedSizeMax = zlibCompressBound(outPacketSize);
+    size_t reservedSize = sizeof(*compressedPacket) - sizeof(compressedPacket->zlibData.buffer) + compressedSizeMax;
+
+    if (!(compressedPacket = replyWriterReserve(replyMsg, reservedSize))) {
+        error("Cannot reserve the zone traffics in the reply.");
+        packetStreamFree(&stream);
+        return;
+    }
+
+    ZlibStream zlibStream;
+    if (!(zlibStreamInit(&zlibStream, &compressedPacket->zlibData, compressedSizeMax))
+    ||  !(zlibStreamWrite(&zlibStream, trafficsData, outPacketSize))
+    ||  !(zlibStreamFinish(&zlibStream))) {
+        error("Cannot compress the zone traffics.");
+        replyWriterTrim(replyMsg, reservedSize);
+        packetStreamFree(&stream);
+        return;
+    }
+    packetStreamFree(&stream);
+
+    outPacketSize = ZLIB_GET_COMPRESSED_PACKET_SIZE(&compressedPacket->zlibData, sizeof(*compressedPacket));
+    packetNormalHeaderInit(&compressedPacket->normalHeader, BC_NORMAL_ZONE_TRAFFIC, outPacketSize);
 
-    zmsg_add(replyMsg, zframe_new(&compressedPacket, outPacketSize));
+    // Give back the space the compression didn't need
+    replyWriterTrim(replyMsg, reservedSize - outPacketSize);
 }
 
 void barrackBuilderBarrackNameChange(BarrackNameChangeStatus status, uint8_t *barrackName, zmsg_t *replyMsg) {
@@ -550,7 +571,7 @@ void barrackBuilderBarrackNameChange(BarrackNameChangeStatus status, uint8_t *ba
     #pragma pack(pop)
 
     PacketType packetType = BC_BARRACKNAME_CHANGE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, BC_BARRACKNAME_CHANGE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -570,7 +591,7 @@ void barrackBuilderCommanderDestroy(uint8_t commanderDestroyMask, zmsg_t *replyM
     #pragma pack(pop)
 
     PacketType packetType = BC_COMMANDER_DESTROY;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, BC_COMMANDER_DESTROY);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -604,7 +625,7 @@ void barrackBuilderCommanderCreate(Commander *commander, uint8_t commandersCount
     PositionXZ commanderDir = PositionXZ_decl(-0.707107f, 0.707107f);
 
     PacketType packetType = BC_COMMANDER_CREATE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE_WAIVED(replyPacket, BC_COMMANDER_CREATE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -639,7 +660,7 @@ void barrackBuilderLogoutOk(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = BC_LOGOUTOK;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, BC_LOGOUTOK);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
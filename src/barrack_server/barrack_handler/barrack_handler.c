@@ -88,13 +88,12 @@ static PacketHandlerState barrackHandlerCheckClientIntegrity(
     (void) clientPacket;
     #pragma pack(pop)
 
-    size_t memSize;
-    void *memory = dumpToMem (
-			"[15:41:52][main.c:57 in HookRecvPacket] >  4F 00 FF FF FF FF 1D 00 04 00 00 00 4B 0A 0F 06 | O...........K...\n"
-			"[15:41:52][main.c:57 in HookRecvPacket] >  01 00 10 01 0C 00 00 00 00 00 00 00 00          | .............\n"
-        , NULL, &memSize);
+    static const uint8_t packetTemplate[] = {
+        0x4F, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x1D, 0x00, 0x04, 0x00, 0x00, 0x00, 0x4B, 0x0A, 0x0F, 0x06,
+        0x01, 0x00, 0x10, 0x01, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
 
-    zmsg_addmem(reply, memory, memSize);
+    replyWriterAppend(reply, packetTemplate, sizeof(packetTemplate));
 
     if (!(barrackHandlerStartBarrack(self, session, packet, packetSize, reply))) {
         error ("Cannot start barrack correctly.");
@@ -343,7 +342,8 @@ static PacketHandlerState barrackHandlerStartGame(
         reply
     );
 
-    status = PACKET_HANDLER_UPDATE_SESSION;
+    // The game session belongs to the zone server now : it must not be written back by the barrack
+    status = PACKET_HANDLER_OK;
 
 cleanup:
     return status;
@@ -59,12 +59,6 @@ bool barrackServerInit(BarrackServer *self, Server *server) {
         error("Cannot allocate a dbSession.");
         return false;
     }
-
-    // Initialize packets manager
-    if (!(packetTypeInit())) {
-        error("Cannot initialize packet manager.");
-        return false;
-    }
 
     return true;
 }
@@ -176,6 +176,31 @@ bool commanderAppearanceCPacketInit (
 }
 
 
+void commanderAppearanceInit(CommanderAppearance *self, Commander *commander) {
+    memset(self, 0, sizeof(*self));
+
+    memcpy(self->commanderName, commander->commanderName, sizeof(self->commanderName));
+    memcpy(self->familyName, commander->familyName, sizeof(self->familyName));
+    self->gender = commander->gender;
+    self->hairId = commander->hairId;
+    self->pose = commander->pose;
+    self->classId = commander->classId;
+    self->jobId = commander->jobId;
+    self->headTop = itemGetId((Item *) commander->inventory.equippedItems[EQSLOT_HAT]);
+
+    self->accountId = commander->accountId;
+    self->pcId = commander->pcId;
+    self->socialInfoId = commander->socialInfoId;
+
+    self->level = commander->level;
+    self->currentHP = commander->currentHP;
+    self->maxHP = commander->maxHP;
+    self->currentSP = commander->currentSP;
+    self->maxSP = commander->maxSP;
+    self->currentStamina = commander->currentStamina;
+    self->maxStamina = commander->maxStamina;
+}
+
 void commanderPrint(Commander *commander) {
     dbg("commanderName = %s", commander->commanderName);
     dbg("familyName = %s", commander->familyName);
@@ -133,6 +133,37 @@ typedef struct
 
 } Commander;
 
+/**
+ * Compact part of a commander needed to show it to the other clients
+ */
+typedef struct
+{
+    /** Appearance */
+    uint8_t commanderName[COMMANDER_NAME_SIZE+1];
+    uint8_t familyName[COMMANDER_FAMILY_NAME_SIZE];
+    CommanderGender_t gender;
+    CommanderHairId_t hairId;
+    CommanderPose_t pose;
+    CommanderClassId_t classId;
+    CommanderJobId_t jobId;
+    ItemId_t headTop;
+
+    /** Identificators */
+    ActorId_t accountId;
+    PcId_t pcId;
+    SocialInfoId_t socialInfoId;
+
+    /** Stats */
+    CommanderLevel_t level;
+    Hp_t currentHP;
+    Hp_t maxHP;
+    Sp_t currentSP;
+    Sp_t maxSP;
+    Stamina_t currentStamina;
+    Stamina_t maxStamina;
+
+} CommanderAppearance;
+
 #pragma pack(push, 1)
 typedef struct
 {
@@ -287,6 +318,13 @@ bool commanderAppearanceCPacketInit (
 
 void commanderPrint(Commander *commander);
 
+/**
+ * @brief Initialize the compact appearance of a commander
+ * @param self An allocated CommanderAppearance to initialize.
+ * @param commander The commander to show to the other clients
+ */
+void commanderAppearanceInit(CommanderAppearance *self, Commander *commander);
+
 /**
  * @brief Duplicate a commander in memory
  */
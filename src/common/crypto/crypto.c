@@ -16,7 +16,39 @@
 #include "schedule.h"
 #include "bf/blowfish.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRYPTO_AVX2_SUPPORTED
+#include <immintrin.h>
+#endif
+
+// ---------- Defines -------------
+/** Number of blocks deciphered at once by the AVX2 path : one per 32 bits lane */
+#define CRYPTO_AVX2_BLOCKS_COUNT 8
+
+/** Number of blocks of the startup self test : two AVX2 batches, and a tail left to the scalar path */
+#define CRYPTO_SELF_TEST_BLOCKS_COUNT (2 * CRYPTO_AVX2_BLOCKS_COUNT + 3)
+
 // ------ Static declaration -------
+/**
+ * @brief Decipher blocksCount consecutive ECB blocks in place
+ */
+typedef void (*CryptoDecryptBlocksFunction)(uint8_t *data, size_t blocksCount);
+
+static void cryptoDecryptBlocksScalar(uint8_t *data, size_t blocksCount);
+#ifdef CRYPTO_AVX2_SUPPORTED
+static void cryptoDecryptBlocksAvx2(uint8_t *data, size_t blocksCount);
+
+/**
+ * @brief Check that an implementation deciphers a fixed vector exactly like the scalar one
+ * @param decryptBlocks The implementation to check
+ * @return true if both outputs match, false otherwise
+ */
+static bool cryptoSelfTest(CryptoDecryptBlocksFunction decryptBlocks);
+#endif
+
+/** Implementation chosen by cryptoInit depending on the CPU */
+static CryptoDecryptBlocksFunction cryptoDecryptBlocks = cryptoDecryptBlocksScalar;
+
 const uint32_t keyIndex = 11;
 const uint32_t numPoint[] = {16, 2, 256, 768};
 const uint32_t seekPoint[] = {4, 1056, 24, 284};
@@ -60,6 +92,19 @@ bool cryptoInit(void) {
 
     BF_set_key_custom_sch((BF_KEY *) schedule, 16, key);
 
+    // Decipher several blocks at once when the CPU allows it
+    #ifdef CRYPTO_AVX2_SUPPORTED
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        if (cryptoSelfTest(cryptoDecryptBlocksAvx2)) {
+            cryptoDecryptBlocks = cryptoDecryptBlocksAvx2;
+            info("Crypto : AVX2 blowfish decryption enabled.");
+        } else {
+            error("Crypto : the AVX2 blowfish decryption doesn't match the scalar one. Keep the scalar one.");
+        }
+    }
+    #endif
+
     return true;
 }
 
@@ -76,12 +121,102 @@ bool cryptoDecryptPacket(uint8_t **packet, size_t *packetSize) {
         return false;
     }
 
-    int blocks = cryptHeader.plainSize / BF_BLOCK;
+    cryptoDecryptBlocks(*packet, cryptHeader.plainSize / BF_BLOCK);
+
+    return true;
+}
+
+// ------ Static function implementation ------
+
+static void cryptoDecryptBlocksScalar(uint8_t *data, size_t blocksCount) {
 
-    for (int i = 0; i < blocks; i++) {
+    for (size_t i = 0; i < blocksCount; i++) {
         size_t offset = i * BF_BLOCK;
-        BF_ecb_encrypt(*packet + offset, *packet + offset, (BF_KEY *) schedule, BF_DECRYPT);
+        BF_ecb_encrypt(data + offset, data + offset, (BF_KEY *) schedule, BF_DECRYPT);
     }
+}
 
-    return true;
+#ifdef CRYPTO_AVX2_SUPPORTED
+/**
+ * @brief One round of blowfish on 8 blocks : LL ^= P ^ F(R), with the 4 S-boxes lookups done by gathers
+ */
+#define CRYPTO_AVX2_BF_ENC(LL, R, S, P)                                                                 \
+    do {                                                                                                \
+        __m256i __mask = _mm256_set1_epi32(0xFF);                                                       \
+        __m256i __a = _mm256_i32gather_epi32((const int *) (S),                                         \
+            _mm256_srli_epi32(R, 24), 4);                                                               \
+        __m256i __b = _mm256_i32gather_epi32((const int *) (S) + 0x100,                                 \
+            _mm256_and_si256(_mm256_srli_epi32(R, 16), __mask), 4);                                     \
+        __m256i __c = _mm256_i32gather_epi32((const int *) (S) + 0x200,                                 \
+            _mm256_and_si256(_mm256_srli_epi32(R, 8), __mask), 4);                                      \
+        __m256i __d = _mm256_i32gather_epi32((const int *) (S) + 0x300,                                 \
+            _mm256_and_si256(R, __mask), 4);                                                            \
+        __m256i __f = _mm256_add_epi32(_mm256_xor_si256(_mm256_add_epi32(__a, __b), __c), __d);          \
+        LL = _mm256_xor_si256(LL, _mm256_xor_si256(_mm256_set1_epi32(P), __f));                         \
+    } while (0)
+
+__attribute__((target("avx2")))
+static void cryptoDecryptBlocksAvx2(uint8_t *data, size_t blocksCount) {
+
+    const BF_KEY *key = (BF_KEY *) schedule;
+    const BF_LONG *p = key->P;
+    const BF_LONG *s = key->S;
+
+    // The blocks are big endian
+    const __m256i byteSwap = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    // [l0 r0 l1 r1 l2 r2 l3 r3] <-> [l0 l1 l2 l3 r0 r1 r2 r3]
+    const __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256i merge = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    size_t i = 0;
+    for (; i + CRYPTO_AVX2_BLOCKS_COUNT <= blocksCount; i += CRYPTO_AVX2_BLOCKS_COUNT) {
+
+        uint8_t *blocks = data + i * BF_BLOCK;
+
+        // Load 8 blocks, and gather their left and right halves
+        __m256i lo = _mm256_loadu_si256((__m256i *) blocks);
+        __m256i hi = _mm256_loadu_si256((__m256i *) (blocks + sizeof(__m256i)));
+        lo = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(lo, byteSwap), split);
+        hi = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(hi, byteSwap), split);
+        __m256i l = _mm256_permute2x128_si256(lo, hi, 0x20);
+        __m256i r = _mm256_permute2x128_si256(lo, hi, 0x31);
+
+        // Same rounds than BF_decrypt
+        l = _mm256_xor_si256(l, _mm256_set1_epi32(p[BF_ROUNDS + 1]));
+        for (int round = BF_ROUNDS; round > 0; round -= 2) {
+            CRYPTO_AVX2_BF_ENC(r, l, s, p[round]);
+            CRYPTO_AVX2_BF_ENC(l, r, s, p[round - 1]);
+        }
+        r = _mm256_xor_si256(r, _mm256_set1_epi32(p[0]));
+
+        // The halves are swapped at the end, as in BF_decrypt
+        lo = _mm256_permute2x128_si256(r, l, 0x20);
+        hi = _mm256_permute2x128_si256(r, l, 0x31);
+        lo = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(lo, merge), byteSwap);
+        hi = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(hi, merge), byteSwap);
+        _mm256_storeu_si256((__m256i *) blocks, lo);
+        _mm256_storeu_si256((__m256i *) (blocks + sizeof(__m256i)), hi);
+    }
+
+    // Remaining blocks
+    cryptoDecryptBlocksScalar(data + i * BF_BLOCK, blocksCount - i);
+}
+
+static bool cryptoSelfTest(CryptoDecryptBlocksFunction decryptBlocks) {
+
+    uint8_t expected[CRYPTO_SELF_TEST_BLOCKS_COUNT * BF_BLOCK];
+    uint8_t result[CRYPTO_SELF_TEST_BLOCKS_COUNT * BF_BLOCK];
+
+    for (size_t i = 0; i < sizeof(expected); i++) {
+        expected[i] = i * 0x9D + 0x3B;
+    }
+    memcpy(result, expected, sizeof(result));
+
+    cryptoDecryptBlocksScalar(expected, CRYPTO_SELF_TEST_BLOCKS_COUNT);
+    decryptBlocks(result, CRYPTO_SELF_TEST_BLOCKS_COUNT);
+
+    return memcmp(expected, result, sizeof(result)) == 0;
 }
+#endif
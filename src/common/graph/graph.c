@@ -19,6 +19,10 @@
 struct Graph {
     // a graph is a hashtable of GraphNode
     zhash_t *nodes;
+
+    // released arcs, chained by their 'next' member, ready to be reused
+    GraphArc *arcsPool;
+    size_t arcsPoolSize;
 };
 
 /**
@@ -38,6 +42,47 @@ static GraphArc *graphArcNew(GraphNode *from, GraphNode *to);
  */
 static bool graphArcInit(GraphArc *self, GraphNode *from, GraphNode *to);
 
+/**
+ * @brief Get an arc from the pool of the graph, or allocate a new one if the pool is empty
+ * @param self A pointer to an allocated Graph.
+ * @param from A source node
+ * @param to A destination node
+ * @return A pointer to an initialized GraphArc, or NULL if an error occurred.
+ */
+static GraphArc *graphArcAcquire(Graph *self, GraphNode *from, GraphNode *to);
+
+/**
+ * @brief Give back an arc to the pool of the graph. The arc is destroyed if the pool is full.
+ * @param self A pointer to an allocated Graph.
+ * @param arc The released arc
+ */
+static void graphArcRelease(Graph *self, GraphArc *arc);
+
+/**
+ * @brief Get the slot of the arcs table where the arc to a given node is, or should be inserted
+ * @param self A pointer to an allocated GraphNode.
+ * @param to The destination node
+ * @return the slot of the arcs table
+ */
+static size_t graphNodeArcSlot(GraphNode *self, GraphNode *to);
+
+/**
+ * @brief Double the capacity of the arcs table of a node
+ * @return true on success, false otherwise
+ */
+static bool graphNodeGrowArcs(GraphNode *self);
+
+/**
+ * @brief Add an arc to the arcs of its source node
+ * @return true on success, false otherwise
+ */
+static bool graphNodeAttachArc(GraphNode *self, GraphArc *arc);
+
+/**
+ * @brief Remove an arc from the arcs of its source node
+ */
+static void graphNodeDetachArc(GraphNode *self, GraphArc *arc);
+
 Graph *graphNew(void) {
     Graph *self;
 
@@ -60,6 +105,9 @@ bool graphInit(Graph *self) {
         return false;
     }
 
+    self->arcsPool = NULL;
+    self->arcsPoolSize = 0;
+
     return true;
 }
 
@@ -82,14 +130,40 @@ static GraphArc *graphArcNew(GraphNode *from, GraphNode *to) {
 static bool graphArcInit(GraphArc *self, GraphNode *from, GraphNode *to) {
     self->from = from;
     self->to = to;
+    self->prev = NULL;
+    self->next = NULL;
     self->user_data = NULL;
 
-    // add the current arc to the arcs list : from -> self
-    zlist_append(self->from->arcs, self);
-
     return true;
 }
 
+static GraphArc *graphArcAcquire(Graph *self, GraphNode *from, GraphNode *to) {
+    GraphArc *arc;
+
+    if (!(arc = self->arcsPool)) {
+        return graphArcNew(from, to);
+    }
+
+    self->arcsPool = arc->next;
+    self->arcsPoolSize--;
+    graphArcInit(arc, from, to);
+
+    return arc;
+}
+
+static void graphArcRelease(Graph *self, GraphArc *arc) {
+    if (self->arcsPoolSize >= GRAPH_ARCS_POOL_MAX_SIZE) {
+        graphArcDestroy(&arc);
+        return;
+    }
+
+    arc->from = arc->to = NULL;
+    arc->prev = NULL;
+    arc->next = self->arcsPool;
+    self->arcsPool = arc;
+    self->arcsPoolSize++;
+}
+
 GraphNode *graphNodeNew(char *hashKey, void *user_data) {
     GraphNode *self;
 
@@ -109,8 +183,12 @@ GraphNode *graphNodeNew(char *hashKey, void *user_data) {
 bool graphNodeInit(GraphNode *self, char *hashKey, void *user_data) {
     self->user_data = user_data;
 
-    if (!(self->arcs = zlist_new())) {
-        error("Cannot allocate a new zlist for arcs.");
+    self->firstArc = self->lastArc = NULL;
+    self->arcsCount = 0;
+    self->arcsCapacity = GRAPH_NODE_ARCS_DEFAULT_CAPACITY;
+
+    if (!(self->arcsTable = calloc(self->arcsCapacity, sizeof(GraphArc *)))) {
+        error("Cannot allocate a new table for arcs.");
         return false;
     }
 
@@ -119,6 +197,111 @@ bool graphNodeInit(GraphNode *self, char *hashKey, void *user_data) {
     return true;
 }
 
+static size_t graphNodeArcSlot(GraphNode *self, GraphNode *to) {
+    // Fibonacci hashing of the node address
+    size_t mask = self->arcsCapacity - 1;
+    size_t slot = (size_t) ((((uintptr_t) to) >> 4) * 11400714819323198485llu) & mask;
+
+    // Linear probing
+    while (self->arcsTable[slot] && self->arcsTable[slot]->to != to) {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+static bool graphNodeGrowArcs(GraphNode *self) {
+    GraphArc **oldTable = self->arcsTable;
+    size_t oldCapacity = self->arcsCapacity;
+
+    if (!(self->arcsTable = calloc(oldCapacity * 2, sizeof(GraphArc *)))) {
+        error("Cannot grow the table of arcs.");
+        self->arcsTable = oldTable;
+        return false;
+    }
+    self->arcsCapacity = oldCapacity * 2;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldTable[i]) {
+            self->arcsTable[graphNodeArcSlot(self, oldTable[i]->to)] = oldTable[i];
+        }
+    }
+
+    free(oldTable);
+
+    return true;
+}
+
+static bool graphNodeAttachArc(GraphNode *self, GraphArc *arc) {
+    // Keep the load factor under 1/2
+    if ((self->arcsCount + 1) * 2 > self->arcsCapacity) {
+        if (!(graphNodeGrowArcs(self))) {
+            error("Cannot grow the arcs of %s.", self->key);
+            return false;
+        }
+    }
+
+    self->arcsTable[graphNodeArcSlot(self, arc->to)] = arc;
+
+    // Append the arc to the arcs list : from -> arc
+    arc->prev = self->lastArc;
+    arc->next = NULL;
+    if (self->lastArc) {
+        self->lastArc->next = arc;
+    } else {
+        self->firstArc = arc;
+    }
+    self->lastArc = arc;
+    self->arcsCount++;
+
+    return true;
+}
+
+static void graphNodeDetachArc(GraphNode *self, GraphArc *arc) {
+    size_t mask = self->arcsCapacity - 1;
+    size_t hole = graphNodeArcSlot(self, arc->to);
+
+    // Backward shift deletion : move back the following arcs of the cluster, so no tombstone is needed
+    self->arcsTable[hole] = NULL;
+    for (size_t slot = (hole + 1) & mask; self->arcsTable[slot]; slot = (slot + 1) & mask) {
+        GraphNode *to = self->arcsTable[slot]->to;
+        size_t home = (size_t) ((((uintptr_t) to) >> 4) * 11400714819323198485llu) & mask;
+
+        // Move the arc only if its home slot isn't between the hole and its current slot
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            self->arcsTable[hole] = self->arcsTable[slot];
+            self->arcsTable[slot] = NULL;
+            hole = slot;
+        }
+    }
+
+    // Unlink it from the arcs list
+    if (arc->prev) {
+        arc->prev->next = arc->next;
+    } else {
+        self->firstArc = arc->next;
+    }
+    if (arc->next) {
+        arc->next->prev = arc->prev;
+    } else {
+        self->lastArc = arc->prev;
+    }
+    arc->prev = arc->next = NULL;
+    self->arcsCount--;
+}
+
+GraphArc *graphNodeFirstArc(GraphNode *self) {
+    return self->firstArc;
+}
+
+GraphArc *graphNodeNextArc(GraphArc *arc) {
+    return arc->next;
+}
+
+size_t graphNodeArcsCount(GraphNode *self) {
+    return self->arcsCount;
+}
+
 bool graphLink(Graph *self, GraphNode *node1, GraphNode *node2) {
 
     if (!(graphAddArc(self, node1, node2))) {
@@ -141,28 +324,23 @@ bool graphUnlink(Graph *self, GraphNode *node1, GraphNode *node2) {
         error("Cannot find link between %s and %s.", node1->key, node2->key);
         return false;
     }
-    zlist_remove(node1->arcs, arc1);
+    graphNodeDetachArc(node1, arc1);
 
     if (!(arc2 = graphNodeGetArc(node2, node1))) {
         error("Cannot find link between %s and %s.", node2->key, node1->key);
+        graphArcRelease(self, arc1);
         return false;
     }
-    zlist_remove(node2->arcs, arc2);
+    graphNodeDetachArc(node2, arc2);
 
-    graphArcDestroy(&arc1);
-    graphArcDestroy(&arc2);
+    graphArcRelease(self, arc1);
+    graphArcRelease(self, arc2);
 
     return true;
 }
 
 GraphArc *graphNodeGetArc(GraphNode *from, GraphNode *to) {
-    for (GraphArc *link = zlist_first(from->arcs); link != NULL; link = zlist_next(from->arcs)) {
-        if (link->to == to) {
-            return link;
-        }
-    }
-
-    return NULL;
+    return from->arcsTable[graphNodeArcSlot(from, to)];
 }
 
 bool graphRemoveNode(Graph *self, GraphNode *node)
@@ -170,7 +348,7 @@ bool graphRemoveNode(Graph *self, GraphNode *node)
     GraphArc *arc;
 
     // Disconnect the node from all other nodes
-    while ((arc = zlist_first(node->arcs)) != NULL) {
+    while ((arc = node->firstArc) != NULL) {
         GraphNode *to = arc->to;
         if (!(graphUnlink(self, node, to))) {
             error ("Cannot unlink %s and %s.", node->key, to->key);
@@ -185,7 +363,12 @@ GraphArc *graphAddArc(Graph *self, GraphNode *from, GraphNode *to) {
     bool status = true;
     GraphArc *arc = NULL;
 
-    if (!(arc = graphArcNew(from, to))) {
+    if ((arc = graphNodeGetArc(from, to))) {
+        // The nodes are already linked
+        return arc;
+    }
+
+    if (!(arc = graphArcAcquire(self, from, to))) {
         error("Cannot create new arc.");
         return NULL;
     }
@@ -206,9 +389,15 @@ GraphArc *graphAddArc(Graph *self, GraphNode *from, GraphNode *to) {
         }
     }
 
+    if (!(graphNodeAttachArc(from, arc))) {
+        error ("Cannot attach the arc to the 'from' node.");
+        status = false;
+        goto cleanup;
+    }
+
 cleanup:
     if (!status) {
-        free(arc);
+        graphArcRelease(self, arc);
         arc = NULL;
     }
 
@@ -244,14 +433,15 @@ void graphDump(Graph *self) {
 
     for (GraphNode *node = zhash_first(self->nodes); node != NULL; node = zhash_next(self->nodes)) {
         dbg("- Arcs of nodes %c :", 'A' + loopCounter++);
-        for (GraphArc *arc = zlist_first(node->arcs); arc != NULL; arc = zlist_next(node->arcs)) {
+        for (GraphArc *arc = graphNodeFirstArc(node); arc != NULL; arc = graphNodeNextArc(arc)) {
             dbg("   %s -> %s", arc->from->key, arc->to->key);
         }
     }
 }
 
 void graphNodeFree(GraphNode *self) {
-    // TODO
+    free(self->arcsTable);
+    free(self->key);
 }
 
 void graphNodeDestroy(GraphNode **_self) {
@@ -281,7 +471,14 @@ void graphArcDestroy(GraphArc **_self) {
 }
 
 void graphFree(Graph *self) {
-    // TODO
+    GraphArc *arc;
+
+    // Destroy the pooled arcs
+    while ((arc = self->arcsPool) != NULL) {
+        self->arcsPool = arc->next;
+        graphArcDestroy(&arc);
+    }
+    self->arcsPoolSize = 0;
 }
 
 void graphDestroy(Graph **_self) {
@@ -18,15 +18,23 @@
 
 #include "R1EMU.h"
 
+#define GRAPH_NODE_ARCS_DEFAULT_CAPACITY 8
+#define GRAPH_ARCS_POOL_MAX_SIZE 4096
+
 // Graph is an opaque structure
 typedef struct Graph Graph;
 
 /**
- * @brief GraphNode contains a list of arcs pointing to neighbors
+ * @brief GraphNode contains a set of arcs pointing to neighbors
  */
 typedef struct GraphNode {
-    // each GraphNode can be linked to [0..*] GraphArcs
-    zlist_t *arcs;
+    // each GraphNode can be linked to [0..*] GraphArcs, kept in insertion order
+    struct GraphArc *firstArc, *lastArc;
+    size_t arcsCount;
+
+    // the same arcs, hashed by destination node with open addressing
+    struct GraphArc **arcsTable;
+    size_t arcsCapacity;
 
     // HashTable key
     char *key;
@@ -42,6 +50,9 @@ typedef struct GraphArc {
     // an GraphArc is located between two nodes
     GraphNode *from, *to;
 
+    // previous and next arcs of the 'from' node
+    struct GraphArc *prev, *next;
+
     // user_data is a user pointer to any data
     void *user_data;
 }   GraphArc;
@@ -81,10 +92,31 @@ bool graphNodeInit(GraphNode *self, char *hashKey, void *user_data);
  * @param self A pointer to an allocated graph.
  * @param from A source node
  * @param to A destination node
- * @return A new GraphArc
+ * @return A new GraphArc, or the existing one if the nodes are already linked
  */
 GraphArc *graphAddArc(Graph *self, GraphNode *from, GraphNode *to);
 
+/**
+ * @brief Get the first arc of a node
+ * @param self A pointer to an allocated GraphNode.
+ * @return the oldest arc of the node, or NULL if it has no arc
+ */
+GraphArc *graphNodeFirstArc(GraphNode *self);
+
+/**
+ * @brief Get the arc following another one in the arcs of its source node
+ * @param arc An arc of a node
+ * @return the next arc, or NULL if it is the last one
+ */
+GraphArc *graphNodeNextArc(GraphArc *arc);
+
+/**
+ * @brief Get the number of arcs of a node
+ * @param self A pointer to an allocated GraphNode.
+ * @return the number of arcs starting from the node
+ */
+size_t graphNodeArcsCount(GraphNode *self);
+
 /**
  * @brief Generate a node hash key
  * @param self A pointer to an allocated GraphNode.
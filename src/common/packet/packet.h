@@ -18,6 +18,7 @@
 
 #include "R1EMU.h"
 #include "packet_type.h"
+#include "reply_writer.h"
 #include "common/crypto/bf/blowfish.h"
 
 #define PACKET_HEADER(x) (typeof(x)[]){x}
@@ -25,31 +26,30 @@
 #define BUILD_REPLY_PACKET(packetName, msgName)                                             \
     for (bool __sent = false;                                                               \
          !__sent && memset(&packetName, 0, sizeof(packetName));                             \
-         zmsg_add(msgName, zframe_new(&packetName, sizeof(packetName))), __sent = true     \
+         replyWriterAppend(msgName, &packetName, sizeof(packetName)), __sent = true         \
     )
 
-#define CHECK_SERVER_PACKET_SIZE(packet, packetType)                                        \
-    do {                                                                                    \
-        if (packetTypeInfo.packets[packetType].size != 0                                    \
-         && sizeof(packet) != packetTypeInfo.packets[packetType].size) {                    \
-            error("The packet size sent isn't the equal to the one in packet_type.h");      \
-            error("The packet size is %d bytes. The waited size is %d bytes.",              \
-                sizeof(packet), packetTypeInfo.packets[packetType].size);                   \
-        }                                                                                   \
-    } while (0);
+/** Reserve the packet directly at the end of the reply, packetPtr points to the zeroed packet to write */
+#define BUILD_REPLY_PACKET_IN_PLACE(packetPtr, msgName)                                     \
+    for (packetPtr = replyWriterReserve(msgName, sizeof(*(packetPtr)));                     \
+         packetPtr != NULL;                                                                 \
+         packetPtr = NULL                                                                   \
+    )
 
-#define CHECK_CLIENT_PACKET_SIZE(packet, packetSize, packetType)                                    \
+#define CHECK_SERVER_PACKET_SIZE(packet, packetType)                                        \
+    _Static_assert(PACKET_TYPE_SIZE(packetType) == 0                                        \
+                || sizeof(packet) == PACKET_TYPE_SIZE(packetType),                          \
+        "The size of " #packet " isn't the size of " #packetType " in packet_type.h")
+
+/** Same as CHECK_SERVER_PACKET_SIZE, for a packet listed in FOREACH_PACKET_SIZE_WAIVER */
+#define CHECK_SERVER_PACKET_SIZE_WAIVED(packet, packetType)                                 \
+    _Static_assert(PACKET_SIZE_WAIVER(packetType) != PACKET_TYPE_SIZE(packetType),          \
+        "The waiver of " #packetType " is obsolete, remove it from packet_type.h");         \
+    _Static_assert(sizeof(packet) == PACKET_SIZE_WAIVER(packetType),                        \
+        "The size of " #packet " isn't the size of the waiver of " #packetType " in packet_type.h")
+
+#define CHECK_CLIENT_PACKET_RECEIVED_SIZE(packet, packetSize)                                       \
     do {                                                                                            \
-        size_t __clientPacketSize = packetTypeInfo.packets[packetType].size                         \
-                                  - sizeof(ClientPacketHeader);                                     \
-        if (packetTypeInfo.packets[packetType].size != 0                                            \
-         && sizeof(packet) != __clientPacketSize) {                                                 \
-            error("The packet size sent isn't the equal to the one in packet_type.h");              \
-            error("The packet size is %d bytes. The waited size is %d bytes.",                      \
-                sizeof(packet), __clientPacketSize);                                                \
-                                                                                                    \
-                return PACKET_HANDLER_ERROR;                                                        \
-        }                                                                                           \
         if (packetSize > (sizeof(packet) + BF_BLOCK) || packetSize < sizeof(packet) ) {             \
             error("The packet size received isn't correct. (packet size = %d, correct size = %d)",  \
                 packetSize, sizeof(packet));                                                        \
@@ -57,6 +57,24 @@
         }                                                                                           \
     } while (0)
 
+#define CHECK_CLIENT_PACKET_SIZE(packet, packetSize, packetType)                                    \
+    do {                                                                                            \
+        _Static_assert(PACKET_TYPE_SIZE(packetType) == 0                                            \
+                    || sizeof(packet) == PACKET_TYPE_SIZE(packetType) - sizeof(ClientPacketHeader), \
+            "The size of " #packet " isn't the size of " #packetType " in packet_type.h");          \
+        CHECK_CLIENT_PACKET_RECEIVED_SIZE(packet, packetSize);                                      \
+    } while (0)
+
+/** Same as CHECK_CLIENT_PACKET_SIZE, for a packet listed in FOREACH_PACKET_SIZE_WAIVER */
+#define CHECK_CLIENT_PACKET_SIZE_WAIVED(packet, packetSize, packetType)                             \
+    do {                                                                                            \
+        _Static_assert(PACKET_SIZE_WAIVER(packetType) != PACKET_TYPE_SIZE(packetType),              \
+            "The waiver of " #packetType " is obsolete, remove it from packet_type.h");             \
+        _Static_assert(sizeof(packet) == PACKET_SIZE_WAIVER(packetType) - sizeof(ClientPacketHeader), \
+            "The size of " #packet " isn't the size of the waiver of " #packetType " in packet_type.h"); \
+        CHECK_CLIENT_PACKET_RECEIVED_SIZE(packet, packetSize);                                      \
+    } while (0)
+
 /**
  * @brief ClientPacketHeader is the header of each packet sent by the client.
  */
@@ -20,6 +20,15 @@
 
 
 // ------ Static declaration -------
+/** Buffer of the last growable stream freed by the current thread, reused by the next one */
+static __thread uint8_t *packetStreamPoolBuffer = NULL;
+static __thread size_t packetStreamPoolCapacity = 0;
+
+/**
+ * @brief Check that dataSize bytes fit at the current position, and grow the buffer if possible
+ * @return true if they fit, false otherwise (the stream is in error)
+ */
+static bool packetStreamEnsure(PacketStream *self, size_t dataSize);
 
 
 // ------ Extern function implementation ------
@@ -48,17 +57,59 @@ void packetStreamInit(PacketStream *self, void *buffer, size_t size) {
     self->function = NULL;
 }
 
-void packetStreamAppend(PacketStream *self, void *data, size_t dataSize) {
+bool packetStreamInitGrowable(PacketStream *self, size_t capacity) {
 
-    if (self->position + dataSize > self->size) {
-        error("Error, cannot get data from the stream in '%s' because it exceeds the stream size '%d' ('%d' requested).",
-              self->function, self->size, self->position + dataSize);
-        return;
+    uint8_t *buffer;
+
+    if (capacity == 0) {
+        capacity = PACKET_STREAM_DEFAULT_CAPACITY;
+    }
+
+    if (packetStreamPoolBuffer && packetStreamPoolCapacity >= capacity) {
+        // Take the buffer of the pool
+        buffer = packetStreamPoolBuffer;
+        capacity = packetStreamPoolCapacity;
+        packetStreamPoolBuffer = NULL;
+        packetStreamPoolCapacity = 0;
+    }
+    else if (!(buffer = malloc(capacity))) {
+        error("Cannot allocate the buffer of the stream.");
+        return false;
+    }
+
+    packetStreamInit(self, buffer, capacity);
+    self->growable = true;
+
+    return true;
+}
+
+bool packetStreamAppend(PacketStream *self, void *data, size_t dataSize) {
+
+    if (!(packetStreamEnsure(self, dataSize))) {
+        return false;
     }
 
     memcpy(&self->buffer[self->position], data, dataSize);
     self->position += dataSize;
     self->sizeExcepted -= dataSize;
+
+    return true;
+}
+
+void *packetStreamReserve(PacketStream *self, size_t dataSize) {
+
+    void *data;
+
+    if (!(packetStreamEnsure(self, dataSize))) {
+        return NULL;
+    }
+
+    data = &self->buffer[self->position];
+    memset(data, 0, dataSize);
+    self->position += dataSize;
+    self->sizeExcepted -= dataSize;
+
+    return data;
 }
 
 void *packetStreamGetCurrentBuffer(PacketStream *self) {
@@ -70,25 +121,91 @@ void *packetStreamGetBuffer(PacketStream *self) {
 }
 
 void packetStreamAddOffset(PacketStream *self, unsigned int offset) {
+
+    if (self->growable) {
+        // The skipped data of a growable stream isn't initialized yet
+        if (!(packetStreamReserve(self, offset))) {
+            return;
+        }
+        self->sizeExcepted += offset;
+        return;
+    }
+
     self->position += offset;
 }
 
-void packetStreamGet(PacketStream *self, void *data, size_t dataSize) {
+bool packetStreamGet(PacketStream *self, void *data, size_t dataSize) {
 
-    if (self->position + dataSize > self->size) {
-        error("Error, cannot get data from the stream in '%s' because it exceeds the stream size '%d' ('%d' requested).",
-              self->function, self->size, self->position + dataSize);
-        return;
+    if (self->error || self->position + dataSize > self->size) {
+        if (!self->error) {
+            error("Error, cannot get data from the stream in '%s' because it exceeds the stream size '%d' ('%d' requested).",
+                  self->function, self->size, self->position + dataSize);
+            self->error = true;
+        }
+        // Don't let the caller read uninitialized data
+        memset(data, 0, dataSize);
+        return false;
     }
 
     memcpy(data, &self->buffer[self->position], dataSize);
     self->position += dataSize;
     self->sizeExcepted -= dataSize;
+
+    return true;
+}
+
+bool packetStreamHasError(PacketStream *self) {
+    return self->error;
+}
+
+void *packetStreamDetach(PacketStream *self, size_t *size) {
+
+    void *buffer = self->buffer;
+
+    if (!self->growable || self->error) {
+        error("Cannot detach the buffer of the stream.");
+        return NULL;
+    }
+
+    *size = self->position;
+    self->buffer = NULL;
+    self->size = 0;
+    self->position = 0;
+
+    return buffer;
+}
+
+void packetStreamFree(PacketStream *self) {
+
+    if (!self->growable) {
+        return;
+    }
+
+    if (!packetStreamPoolBuffer && self->buffer && self->size <= PACKET_STREAM_POOL_MAX_CAPACITY) {
+        // Keep it for the next growable stream of this thread
+        packetStreamPoolBuffer = self->buffer;
+        packetStreamPoolCapacity = self->size;
+    } else {
+        free(self->buffer);
+    }
+
+    self->buffer = NULL;
+    self->size = 0;
+    self->position = 0;
+}
+
+void packetStreamPoolFree(void) {
+    free(packetStreamPoolBuffer);
+    packetStreamPoolBuffer = NULL;
+    packetStreamPoolCapacity = 0;
 }
 
 void packetStreamDestroy(PacketStream **_self) {
     PacketStream *self = *_self;
 
+    if (self) {
+        packetStreamFree(self);
+    }
     free(self);
     *_self = NULL;
 }
@@ -115,3 +232,40 @@ bool _packetStreamDebugEnd(PacketStream *self, const char *function) {
     return true;
 }
 
+// ------ Static function implementation -------
+
+static bool packetStreamEnsure(PacketStream *self, size_t dataSize) {
+
+    if (self->error) {
+        return false;
+    }
+
+    if (self->position + dataSize <= self->size) {
+        return true;
+    }
+
+    if (!self->growable) {
+        error("Error, cannot write data in the stream in '%s' because it exceeds the stream size '%d' ('%d' requested).",
+              self->function, self->size, self->position + dataSize);
+        self->error = true;
+        return false;
+    }
+
+    // Double the buffer, or more if it isn't enough
+    size_t newSize = self->size * 2;
+    if (newSize < self->position + dataSize) {
+        newSize = self->position + dataSize;
+    }
+
+    uint8_t *newBuffer;
+    if (!(newBuffer = realloc(self->buffer, newSize))) {
+        error("Cannot grow the stream in '%s' to %d bytes.", self->function, newSize);
+        self->error = true;
+        return false;
+    }
+
+    self->buffer = newBuffer;
+    self->size = newSize;
+
+    return true;
+}
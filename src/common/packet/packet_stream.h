@@ -25,6 +25,18 @@
 #define packetStreamOut(self, data) \
     packetStreamGet(self, (void *) (data), sizeof(*(data)))
 
+#define packetStreamInArray(self, array, count) \
+    packetStreamAppend(self, (void *) (array), sizeof(*(array)) * (count))
+
+#define packetStreamOutArray(self, array, count) \
+    packetStreamGet(self, (void *) (array), sizeof(*(array)) * (count))
+
+/** Default capacity of a growable PacketStream */
+#define PACKET_STREAM_DEFAULT_CAPACITY 1024
+
+/** Bigger buffers aren't kept in the pool of the thread after use */
+#define PACKET_STREAM_POOL_MAX_CAPACITY (64 * 1024)
+
 /**
  * @brief PacketStream is a buffer with a pointer to the last data written
  *
@@ -35,6 +47,12 @@ struct PacketStream {
     size_t size;
     unsigned int position;
 
+    // A growable stream owns its buffer, and reallocates it when it is full
+    bool growable;
+
+    // Sticky : once an access failed, the next ones are ignored
+    bool error;
+
     // Debug
     int sizeExcepted;
     const char *function;
@@ -57,6 +75,15 @@ PacketStream *packetStreamNew(void *buffer, size_t size);
  */
 void packetStreamInit(PacketStream *self, void *buffer, size_t size);
 
+/**
+ * @brief Initialize an allocated PacketStream structure with its own buffer, growing with the data written.
+ *        The buffer comes from the pool of the current thread when possible.
+ * @param self An allocated PacketStream to initialize.
+ * @param capacity The initial size of the buffer, PACKET_STREAM_DEFAULT_CAPACITY if 0
+ * @return true on success, false otherwise.
+ */
+bool packetStreamInitGrowable(PacketStream *self, size_t capacity);
+
 /**
  * @brief Move the position depending of the offset argument (position = position + offet)
  * @param self An allocated PacketStream
@@ -64,6 +91,15 @@ void packetStreamInit(PacketStream *self, void *buffer, size_t size);
  */
 void packetStreamAddOffset(PacketStream *self, unsigned int offset);
 
+/**
+ * @brief Get contiguous space at the current position and move the position after it.
+ *        The pointer is only valid until the next write, as a growable stream can move its buffer.
+ * @param self An allocated PacketStream
+ * @param dataSize The size of the space to reserve
+ * @return A pointer to the zeroed space, NULL if the stream is in error
+ */
+void *packetStreamReserve(PacketStream *self, size_t dataSize);
+
 /**
  * @brief Get the stream at the current position
  * @param self An allocated PacketStream
@@ -76,22 +112,49 @@ void *packetStreamGetBuffer(PacketStream *self);
  * @param self An allocated PacketStream
  * @param data The data to append to the packet
  * @param dataSize the size of the data
- * @return
+ * @return false if the stream is in error
  */
-void packetStreamAppend(PacketStream *self, void *data, size_t dataSize);
+bool packetStreamAppend(PacketStream *self, void *data, size_t dataSize);
 
 /**
  * @brief Get the data from the current stream position and remove it
  * @param self An allocated PacketStream
  * @param data The data to append to the packet
  * @param dataSize the size of the data
- * @return
+ * @return false if the stream is in error
+ */
+bool packetStreamGet(PacketStream *self, void *data, size_t dataSize);
+
+/**
+ * @brief Check if an access to the stream failed since its initialization
+ * @param self An allocated PacketStream
+ * @return true if the data of the stream is incomplete, false otherwise
+ */
+bool packetStreamHasError(PacketStream *self);
+
+/**
+ * @brief Take the buffer of a growable stream, without copy. The stream is empty afterward.
+ * @param self An allocated growable PacketStream
+ * @param[out] size The size of the data written in the buffer
+ * @return The buffer to free by the caller, NULL if the stream is in error
+ */
+void *packetStreamDetach(PacketStream *self, size_t *size);
+
+/**
+ * @brief Free the buffer of a growable stream, or give it back to the pool of the current thread.
+ *        It does nothing for a stream using the buffer of the caller.
+ * @param self An allocated PacketStream
+ */
+void packetStreamFree(PacketStream *self);
+
+/**
+ * @brief Free the buffer kept in the pool of the current thread
  */
-void packetStreamGet(PacketStream *self, void *data, size_t dataSize);
+void packetStreamPoolFree(void);
 
 /**
  * @brief Free an allocated PacketStream structure and nullify the content of the pointer.
- *  It does *NOT* free the content of the stream, only the structure
+ *  It does *NOT* free the content of the stream given by the caller, only the structure and the buffer of a growable stream
  * @param self A pointer to an allocated PacketStream.
  */
 void packetStreamDestroy(PacketStream **self);
@@ -24,8 +24,20 @@
 
 #define GENERATE_PACKET_TYPE_ENUM(name, id, size) \
 	name = id,
+#define GENERATE_PACKET_TYPE_SIZE(name, id, size) \
+	PACKET_SIZE_##name = size,
 #define GENERATE_PACKET_TYPE_ENTRY(_name, _id, _size) \
-	{_id, _size, #_name},
+	[_id] = {_id, _size, #_name},
+#define GENERATE_PACKET_SIZE_WAIVER(name, structSize) \
+	PACKET_SIZE_WAIVER_##name = structSize,
+
+/** Size of a packet type known at compilation, 0 if it has a variable size */
+#define PACKET_TYPE_SIZE(name) \
+	PACKET_SIZE_##name
+
+/** Size of the struct of a packet type waived from the size checks */
+#define PACKET_SIZE_WAIVER(name) \
+	PACKET_SIZE_WAIVER_##name
 
 // ------ Structure declaration -------
 #define FOREACH_PACKET_TYPE(GENERATOR) \
@@ -615,6 +627,22 @@
     GENERATOR(CZ_DUMMYPC_SKILL_POS, 3595, 26) \
 
 
+/**
+ * The structs of these packets don't have the size of the protocol yet.
+ * Each waiver gives the size of the struct : the check fails again as soon as the struct changes,
+ * and the waiver must be removed once the struct has the size of the protocol.
+ */
+#define FOREACH_PACKET_SIZE_WAIVER(GENERATOR) \
+    GENERATOR(BC_COMMANDER_CREATE, 318) \
+    GENERATOR(CS_LOGIN, 68) \
+    GENERATOR(CZ_SKILL_GROUND, 57) \
+    GENERATOR(CZ_POSE, 32) \
+    GENERATOR(ZC_ENTER_PC, 370) \
+    GENERATOR(ZC_SKILL_READY, 46) \
+    GENERATOR(ZC_POSE, 32) \
+    GENERATOR(ZC_SKILL_RANGE_DBG, 56) \
+    GENERATOR(ZC_SKILL_RANGE_CIRCLE, 26) \
+
 /**
  * @brief PacketType enumerates all the packets used in the game between the client and the server
  */
@@ -623,6 +651,15 @@ typedef enum PacketType {
 	PACKET_TYPE_COUNT
 }	PacketType;
 
+/**
+ * @brief PacketTypeSize enumerates the size of each packet, so they can be checked during the compilation,
+ *        and the size of the structs of the waived packets
+ */
+typedef enum PacketTypeSize {
+	FOREACH_PACKET_TYPE(GENERATE_PACKET_TYPE_SIZE)
+	FOREACH_PACKET_SIZE_WAIVER(GENERATE_PACKET_SIZE_WAIVER)
+}	PacketTypeSize;
+
 typedef struct PacketTypeEntry {
     int id;
     int size;
@@ -633,16 +670,19 @@ typedef struct PacketTypeEntry {
  * @brief PacketTypeInfo enumerates all the packets used in the game between the client and the server.
  *        It gives more info than PacketType (packet size and string)
  *        Its purpose is to give information during runtime execution, contrary to PacketType that is used during the compilation.
+ *        It is built during the compilation from FOREACH_PACKET_TYPE.
  */
 typedef struct PacketTypeInfo {
     PacketTypeEntry packets[PACKET_TYPES_MAX_INDEX];
 } PacketTypeInfo;
 
 // global packet types
-extern PacketTypeInfo packetTypeInfo;
+extern const PacketTypeInfo packetTypeInfo;
 
 // ----------- Functions ------------
-char *
-PacketType_to_string (PacketType type);
-
-bool packetTypeInit(void);
+/**
+ * @brief Get the name of a packet type
+ * @param type The packet type
+ * @return The name of the packet type, "UNKNOWN_PACKET" if it doesn't exist
+ */
+char *packetTypeToString(PacketType type);
@@ -0,0 +1,260 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "reply_writer.h"
+
+// ------ Structure declaration -------
+/**
+ * @brief ReplyWriter is a growable buffer containing the packets of a reply
+ */
+struct ReplyWriter
+{
+    // the reply message bound to the writer, NULL when no reply is being built
+    zmsg_t *msg;
+
+    // the packets written, NULL after the buffer has been handed to ZMQ
+    uint8_t *buffer;
+    size_t size;
+    size_t capacity;
+};
+
+// ------ Static declaration -------
+/** The writer bound to a reply in the current thread : a Worker builds one reply at a time */
+static __thread ReplyWriter *replyWriterBound = NULL;
+
+/**
+ * @brief Get the writer bound to a reply message
+ * @return the writer, or NULL if the message isn't bound in the current thread
+ */
+static ReplyWriter *replyWriterGet(zmsg_t *msg);
+
+/**
+ * @brief Free a buffer once ZMQ has sent it
+ */
+static void replyWriterFreeBuffer(void *buffer, void *hint);
+
+
+// ------ Extern function implementation -------
+
+ReplyWriter *replyWriterNew(size_t capacity) {
+    ReplyWriter *self;
+
+    if ((self = calloc(1, sizeof(ReplyWriter))) == NULL) {
+        return NULL;
+    }
+
+    if (!replyWriterInit(self, capacity)) {
+        replyWriterDestroy(&self);
+        error("ReplyWriter failed to initialize.");
+        return NULL;
+    }
+
+    return self;
+}
+
+bool replyWriterInit(ReplyWriter *self, size_t capacity) {
+
+    self->msg = NULL;
+    self->size = 0;
+    self->capacity = capacity;
+
+    if (capacity == 0) {
+        error("The capacity of the writer cannot be null.");
+        return false;
+    }
+
+    if (!(self->buffer = malloc(capacity))) {
+        error("Cannot allocate the buffer of the writer.");
+        return false;
+    }
+
+    return true;
+}
+
+void replyWriterBegin(ReplyWriter *self, zmsg_t *msg) {
+    self->msg = msg;
+    self->size = 0;
+    replyWriterBound = self;
+}
+
+void *replyWriterReserve(zmsg_t *msg, size_t packetSize) {
+
+    ReplyWriter *self;
+    uint8_t *packet;
+
+    if (!(self = replyWriterGet(msg))) {
+        // Not bound : the packet gets its own frame
+        zframe_t *frame;
+        if (!(frame = zframe_new(NULL, packetSize))) {
+            error("Cannot allocate a new frame.");
+            return NULL;
+        }
+        packet = zframe_data(frame);
+        zmsg_append(msg, &frame);
+        memset(packet, 0, packetSize);
+        return packet;
+    }
+
+    // The previous buffer has been given to ZMQ, or is too small
+    if (!self->buffer || self->size + packetSize > self->capacity) {
+
+        size_t capacity = self->capacity;
+        while (self->size + packetSize > capacity) {
+            capacity *= 2;
+        }
+
+        uint8_t *buffer;
+        if (!(buffer = realloc(self->buffer, capacity))) {
+            error("Cannot grow the buffer of the writer to %d bytes.", capacity);
+            return NULL;
+        }
+
+        self->buffer = buffer;
+        self->capacity = capacity;
+    }
+
+    packet = &self->buffer[self->size];
+    self->size += packetSize;
+    memset(packet, 0, packetSize);
+
+    return packet;
+}
+
+bool replyWriterTrim(zmsg_t *msg, size_t unusedSize) {
+
+    ReplyWriter *self;
+
+    if (!(self = replyWriterGet(msg))) {
+        // Not bound : the frame of the packet cannot shrink, replace it
+        zframe_t *frame = zmsg_last(msg);
+        zframe_t *trimmedFrame;
+
+        if (!frame || zframe_size(frame) < unusedSize) {
+            error("Cannot trim %d bytes from the last packet.", unusedSize);
+            return false;
+        }
+
+        if (!(trimmedFrame = zframe_new(zframe_data(frame), zframe_size(frame) - unusedSize))) {
+            error("Cannot allocate a new frame.");
+            return false;
+        }
+
+        zmsg_remove(msg, frame);
+        zframe_destroy(&frame);
+        zmsg_append(msg, &trimmedFrame);
+        return true;
+    }
+
+    if (self->size < unusedSize) {
+        error("Cannot trim %d bytes from the last packet.", unusedSize);
+        return false;
+    }
+
+    self->size -= unusedSize;
+    return true;
+}
+
+bool replyWriterAppend(zmsg_t *msg, const void *packet, size_t packetSize) {
+
+    void *reserved;
+
+    if (!(reserved = replyWriterReserve(msg, packetSize))) {
+        return false;
+    }
+
+    memcpy(reserved, packet, packetSize);
+    return true;
+}
+
+bool replyWriterSend(ReplyWriter *self, zmsg_t **_msg, zsock_t *socket) {
+
+    bool status = false;
+    zmsg_t *msg = *_msg;
+    zframe_t *frame = NULL;
+    zmq_msg_t packets;
+
+    // Unbind the reply first, the buffer belongs to the next reply whatever happens
+    self->msg = NULL;
+    replyWriterBound = NULL;
+
+    if (self->size == 0) {
+        // No packet : the message is sent as it is
+        if (zmsg_send(_msg, socket) != 0) {
+            error("Cannot send the reply.");
+            goto cleanup;
+        }
+        status = true;
+        goto cleanup;
+    }
+
+    // Send the frames of the message first
+    while ((frame = zmsg_pop(msg))) {
+        if (zframe_send(&frame, socket, ZFRAME_MORE) != 0) {
+            error("Cannot send the headers of the reply.");
+            goto cleanup;
+        }
+    }
+
+    // Then the packets, in a single frame : ZMQ owns the buffer from now on
+    if (zmq_msg_init_data(&packets, self->buffer, self->size, replyWriterFreeBuffer, NULL) != 0) {
+        error("Cannot initialize the packets frame.");
+        goto cleanup;
+    }
+    self->buffer = NULL;
+
+    if (zmq_msg_send(&packets, zsock_resolve(socket), 0) == -1) {
+        error("Cannot send the packets of the reply.");
+        zmq_msg_close(&packets);
+        goto cleanup;
+    }
+
+    status = true;
+
+cleanup:
+    self->size = 0;
+    zframe_destroy(&frame);
+    zmsg_destroy(_msg);
+    return status;
+}
+
+void replyWriterFree(ReplyWriter *self) {
+    if (replyWriterBound == self) {
+        replyWriterBound = NULL;
+    }
+    free(self->buffer);
+}
+
+void replyWriterDestroy(ReplyWriter **_self) {
+    ReplyWriter *self = *_self;
+
+    if (self) {
+        replyWriterFree(self);
+        free(self);
+    }
+
+    *_self = NULL;
+}
+
+// ------ Static function implementation -------
+
+static ReplyWriter *replyWriterGet(zmsg_t *msg) {
+
+    ReplyWriter *self = replyWriterBound;
+
+    return (self && self->msg == msg) ? self : NULL;
+}
+
+static void replyWriterFreeBuffer(void *buffer, void *hint) {
+    free(buffer);
+}
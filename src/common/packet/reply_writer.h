@@ -0,0 +1,105 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file reply_writer.h
+ * @brief ReplyWriter gathers the packets of a reply in a single buffer.
+ *
+ * A Worker binds its ReplyWriter to the reply message of the request it processes.
+ * The builders then write their packets in place at the end of the buffer, one after the other,
+ * and the whole buffer is handed to ZMQ as the last frame of the reply, without being copied.
+ * The client reads a stream of packets, so they don't need a frame each.
+ *
+ * A message not bound to a writer (e.g. built by the EventServer) still gets a new frame per packet.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+// ---------- Includes ------------
+#include "R1EMU.h"
+
+// ---------- Defines -------------
+/** Initial size of the buffer of a writer, it grows with the biggest reply */
+#define REPLY_WRITER_DEFAULT_CAPACITY (16 * 1024)
+
+// ------ Structure declaration -------
+typedef struct ReplyWriter ReplyWriter;
+
+// ----------- Functions ------------
+/**
+ * @brief Allocate a new ReplyWriter structure.
+ * @param capacity The initial size of the buffer
+ * @return A pointer to an allocated ReplyWriter, or NULL if an error occured.
+ */
+ReplyWriter *replyWriterNew(size_t capacity);
+
+/**
+ * @brief Initialize an allocated ReplyWriter structure.
+ * @param self An allocated ReplyWriter to initialize.
+ * @param capacity The initial size of the buffer
+ * @return true on success, false otherwise.
+ */
+bool replyWriterInit(ReplyWriter *self, size_t capacity);
+
+/**
+ * @brief Bind the writer to a reply message, for the current thread, until the reply is sent.
+ * @param self An allocated ReplyWriter
+ * @param msg The reply message
+ */
+void replyWriterBegin(ReplyWriter *self, zmsg_t *msg);
+
+/**
+ * @brief Reserve a zeroed packet at the end of a reply, to be written in place.
+ *        The packet stays valid until the next packet is added to the reply.
+ * @param msg The reply message
+ * @param packetSize The size of the packet
+ * @return a pointer to the packet, or NULL if an error occured
+ */
+void *replyWriterReserve(zmsg_t *msg, size_t packetSize);
+
+/**
+ * @brief Give back the unused end of the last packet reserved in a reply,
+ *        when its final size is only known once written.
+ * @param msg The reply message
+ * @param unusedSize The size to remove at the end of the packet
+ * @return true on success, false otherwise
+ */
+bool replyWriterTrim(zmsg_t *msg, size_t unusedSize);
+
+/**
+ * @brief Copy a packet at the end of a reply.
+ * @param msg The reply message
+ * @param packet The packet to add
+ * @param packetSize The size of the packet
+ * @return true on success, false otherwise
+ */
+bool replyWriterAppend(zmsg_t *msg, const void *packet, size_t packetSize);
+
+/**
+ * @brief Send the reply bound to the writer, and unbind it. The packets are sent as a single frame, without copy.
+ * @param self An allocated ReplyWriter
+ * @param msg A pointer to the reply message, destroyed in any case
+ * @param socket The socket to send the reply to
+ * @return true on success, false otherwise
+ */
+bool replyWriterSend(ReplyWriter *self, zmsg_t **msg, zsock_t *socket);
+
+/**
+ * @brief Free an allocated ReplyWriter structure.
+ * @param self A pointer to an allocated ReplyWriter.
+ */
+void replyWriterFree(ReplyWriter *self);
+
+/**
+ * @brief Free an allocated ReplyWriter structure and nullify the content of the pointer.
+ * @param self A pointer to an allocated ReplyWriter.
+ */
+void replyWriterDestroy(ReplyWriter **self);
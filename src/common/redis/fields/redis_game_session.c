@@ -15,6 +15,9 @@
 // ---------- Includes ------------
 #include "redis_game_session.h"
 #include "redis_socket_session.h"
+#include "redis_game_session_blob.h"
+#include "redis_map_index.h"
+#include "common/redis/redis_scripts.h"
 #include "common/utils/math.h"
 #include "common/actor/item/item_factory.h"
 
@@ -98,16 +101,20 @@ const char *redisGameSessionsStr [] = {
 
 bool redisGetAccountSession(Redis *self, RedisAccountSessionKey *key, AccountSession *accountSession) {
 
+    #ifdef __REDIS_GAME_SESSION_BLOB__
+    return redisGetAccountSessionBlob(self, key, accountSession);
+    #endif
+
     bool result = false;
     redisReply *reply = NULL;
 
     reply = redisCommandDbg(self,
-        "HMGET zone%x:map%x:acc%llx"
+        "HMGET " REDIS_GAME_SESSION_KEY_FORMAT
         " " REDIS_SESSION_account_accountName_str
         " " REDIS_SESSION_account_sessionKey_str
         " " REDIS_SESSION_account_privilege_str
         " " REDIS_SESSION_account_commandersCountMax_str
-        , key->routerId, key->mapId, key->accountId
+        , key->accountId
     );
 
     if (!reply) {
@@ -156,13 +163,17 @@ cleanup:
 
 bool redisGetGameSession(Redis *self, RedisGameSessionKey *key, GameSession *gameSession) {
 
+    #ifdef __REDIS_GAME_SESSION_BLOB__
+    return redisGetGameSessionBlob(self, key, gameSession);
+    #endif
+
     memset(gameSession, 0, sizeof(*gameSession));
 
     bool result = false;
     redisReply *reply = NULL;
 
     reply = redisCommandDbg(self,
-        "HMGET zone%x:map%x:acc%llx"
+        "HMGET " REDIS_GAME_SESSION_KEY_FORMAT
         /** Keep these fields in the same order than the RedisGameSessionFields fields one */
         // Account
         " " REDIS_SESSION_account_accountName_str
@@ -219,7 +230,7 @@ bool redisGetGameSession(Redis *self, RedisGameSessionKey *key, GameSession *gam
         " " REDIS_SESSION_EQSLOT_RING_RIGHT_str
         " " REDIS_SESSION_EQSLOT_NECKLACE_str
 
-        , key->routerId, key->mapId, key->accountId
+        , key->accountId
     );
 
     if (!reply) {
@@ -238,89 +249,10 @@ bool redisGetGameSession(Redis *self, RedisGameSessionKey *key, GameSession *gam
             // info("Redis status : %s", reply->str);
             break;
 
-        case REDIS_REPLY_ARRAY: {
-            // Check the number of elements retrieved
-            if (reply->elements != REDIS_SESSION_COUNT) {
-                error("Wrong number of elements received.");
+        case REDIS_REPLY_ARRAY:
+            if (!(redisGameSessionFromHashReply(reply, gameSession))) {
                 goto cleanup;
             }
-
-            // Check if any element of the reply is NULL
-            size_t elementIndex;
-            if ((elementIndex = redisAnyElementIsNull (reply->element, reply->elements)) != -1) {
-                error("Element <%s> returned by Redis is NULL.", redisGameSessionsStr[elementIndex]);
-                goto cleanup;
-            }
-
-            /// Write the reply to the session
-            // Account
-            COPY_REDIS_GAME_STR(gameSession->accountSession.accountName, account_accountName);
-            COPY_REDIS_GAME_STR(gameSession->accountSession.sessionKey, account_sessionKey);
-            gameSession->accountSession.privilege = GET_REDIS_GAME_32(account_privilege);
-            gameSession->accountSession.commandersCountMax = GET_REDIS_GAME_32(account_commandersCountMax);
-
-            CommanderSession *commanderSession = &gameSession->commanderSession;
-            Commander *commander = commanderSession->currentCommander = commanderNew();
-
-            // Commander
-            COPY_REDIS_GAME_STR(commander->commanderName, commander_commanderName);
-            COPY_REDIS_GAME_STR(commander->familyName, commander_familyName);
-            commander->accountId = GET_REDIS_GAME_64(commander_accountId);
-            commander->classId   = GET_REDIS_GAME_32(commander_classId);
-            commander->jobId     = GET_REDIS_GAME_32(commander_jobId);
-            commander->gender    = GET_REDIS_GAME_32(commander_gender);
-            commander->level     = GET_REDIS_GAME_32(commander_level);
-            commander->hairId    = GET_REDIS_GAME_32(commander_hairId);
-            commander->pose      = GET_REDIS_GAME_32(commander_pose);
-            commander->mapId = GET_REDIS_GAME_32(commander_mapId);
-            commander->pos.x = GET_REDIS_GAME_FLOAT(commander_posX);
-            commander->pos.y = GET_REDIS_GAME_FLOAT(commander_posY);
-            commander->pos.z = GET_REDIS_GAME_FLOAT(commander_posZ);
-            commander->barrackPos.x = GET_REDIS_GAME_FLOAT(commander_barrackPosX);
-            commander->barrackPos.y = GET_REDIS_GAME_FLOAT(commander_barrackPosY);
-            commander->barrackPos.z = GET_REDIS_GAME_FLOAT(commander_barrackPosZ);
-            commander->currentXP = GET_REDIS_GAME_32(commander_currentXP);
-            commander->maxXP = GET_REDIS_GAME_32(commander_maxXP);
-            commander->pcId = GET_REDIS_GAME_32(commander_pcId);
-            commander->socialInfoId = GET_REDIS_GAME_64(commander_socialInfoId);
-            commander->commanderId = GET_REDIS_GAME_64(commander_commanderId);
-            commander->currentHP = GET_REDIS_GAME_32(commander_currentHP);
-            commander->maxHP = GET_REDIS_GAME_32(commander_maxHP);
-            commander->currentSP = GET_REDIS_GAME_32(commander_currentSP);
-            commander->maxSP = GET_REDIS_GAME_32(commander_maxSP);
-            commander->currentStamina = GET_REDIS_GAME_32(commander_currentStamina);
-            commander->maxStamina = GET_REDIS_GAME_32(commander_maxStamina);
-
-            // Equipment
-            #define GET_REDIS_EQUIPMENT(x)                                                                     \
-              if (!(commander->inventory.equippedItems[x] = (ItemEquipable *) itemFactoryCreate(               \
-                     GET_REDIS_GAME_32(x), 1)))                                                                \
-              {                                                                                                \
-                    error("Cannot get item '%s'", STRINGIFY(x));                                               \
-                    goto cleanup;                                                                              \
-              }                                                                                                \
-
-            GET_REDIS_EQUIPMENT(EQSLOT_HAT);
-            GET_REDIS_EQUIPMENT(EQSLOT_HAT_L);
-            GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN1);
-            GET_REDIS_EQUIPMENT(EQSLOT_BODY_ARMOR);
-            GET_REDIS_EQUIPMENT(EQSLOT_GLOVES);
-            GET_REDIS_EQUIPMENT(EQSLOT_BOOTS);
-            GET_REDIS_EQUIPMENT(EQSLOT_HELMET);
-            GET_REDIS_EQUIPMENT(EQSLOT_BRACELET);
-            GET_REDIS_EQUIPMENT(EQSLOT_WEAPON);
-            GET_REDIS_EQUIPMENT(EQSLOT_SHIELD);
-            GET_REDIS_EQUIPMENT(EQSLOT_COSTUME);
-            GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN3);
-            GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN4);
-            GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN5);
-            GET_REDIS_EQUIPMENT(EQSLOT_LEG_ARMOR);
-            GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN6);
-            GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN7);
-            GET_REDIS_EQUIPMENT(EQSLOT_RING_LEFT);
-            GET_REDIS_EQUIPMENT(EQSLOT_RING_RIGHT);
-            GET_REDIS_EQUIPMENT(EQSLOT_NECKLACE);
-        }
         break;
 
         default :
@@ -339,34 +271,266 @@ cleanup:
     return result;
 }
 
-bool redisGetGameSessionBySocketId(Redis *self, RouterId_t routerId, uint8_t *sessionKey, GameSession *gameSession) {
+bool redisGameSessionFromHashReply(redisReply *reply, GameSession *gameSession) {
 
-    SocketSession socketSession;
-    RedisSocketSessionKey socketKey = {
-        .routerId = routerId,
-        .sessionKey = sessionKey
-    };
-    if (!(redisGetSocketSession(self, &socketKey, &socketSession))) {
-        error("Cannot get the socket session of the client.");
+    // Check the number of elements retrieved
+    if (reply->elements != REDIS_SESSION_COUNT) {
+        error("Wrong number of elements received.");
         return false;
     }
 
-    RedisGameSessionKey gameKey = {
-        .routerId = socketSession.routerId,
-        .mapId = socketSession.mapId,
-        .accountId = socketSession.accountId
-    };
+    // Check if any element of the reply is NULL
+    size_t elementIndex;
+    if ((elementIndex = redisAnyElementIsNull (reply->element, reply->elements)) != -1) {
+        error("Element <%s> returned by Redis is NULL.", redisGameSessionsStr[elementIndex]);
+        return false;
+    }
 
-    if (!(redisGetGameSession(self, &gameKey, gameSession))) {
-        error("Cannot get the game session of the client.");
+    /// Write the reply to the session
+    // Account
+    COPY_REDIS_GAME_STR(gameSession->accountSession.accountName, account_accountName);
+    COPY_REDIS_GAME_STR(gameSession->accountSession.sessionKey, account_sessionKey);
+    gameSession->accountSession.privilege = GET_REDIS_GAME_32(account_privilege);
+    gameSession->accountSession.commandersCountMax = GET_REDIS_GAME_32(account_commandersCountMax);
+
+    CommanderSession *commanderSession = &gameSession->commanderSession;
+    Commander *commander = commanderSession->currentCommander = commanderNew();
+
+    // Commander
+    COPY_REDIS_GAME_STR(commander->commanderName, commander_commanderName);
+    COPY_REDIS_GAME_STR(commander->familyName, commander_familyName);
+    commander->accountId = GET_REDIS_GAME_64(commander_accountId);
+    commander->classId   = GET_REDIS_GAME_32(commander_classId);
+    commander->jobId     = GET_REDIS_GAME_32(commander_jobId);
+    commander->gender    = GET_REDIS_GAME_32(commander_gender);
+    commander->level     = GET_REDIS_GAME_32(commander_level);
+    commander->hairId    = GET_REDIS_GAME_32(commander_hairId);
+    commander->pose      = GET_REDIS_GAME_32(commander_pose);
+    commander->mapId = GET_REDIS_GAME_32(commander_mapId);
+    commander->pos.x = GET_REDIS_GAME_FLOAT(commander_posX);
+    commander->pos.y = GET_REDIS_GAME_FLOAT(commander_posY);
+    commander->pos.z = GET_REDIS_GAME_FLOAT(commander_posZ);
+    commander->barrackPos.x = GET_REDIS_GAME_FLOAT(commander_barrackPosX);
+    commander->barrackPos.y = GET_REDIS_GAME_FLOAT(commander_barrackPosY);
+    commander->barrackPos.z = GET_REDIS_GAME_FLOAT(commander_barrackPosZ);
+    commander->currentXP = GET_REDIS_GAME_32(commander_currentXP);
+    commander->maxXP = GET_REDIS_GAME_32(commander_maxXP);
+    commander->pcId = GET_REDIS_GAME_32(commander_pcId);
+    commander->socialInfoId = GET_REDIS_GAME_64(commander_socialInfoId);
+    commander->commanderId = GET_REDIS_GAME_64(commander_commanderId);
+    commander->currentHP = GET_REDIS_GAME_32(commander_currentHP);
+    commander->maxHP = GET_REDIS_GAME_32(commander_maxHP);
+    commander->currentSP = GET_REDIS_GAME_32(commander_currentSP);
+    commander->maxSP = GET_REDIS_GAME_32(commander_maxSP);
+    commander->currentStamina = GET_REDIS_GAME_32(commander_currentStamina);
+    commander->maxStamina = GET_REDIS_GAME_32(commander_maxStamina);
+
+    // Equipment
+    #define GET_REDIS_EQUIPMENT(x)                                                                     \
+      if (!(commander->inventory.equippedItems[x] = (ItemEquipable *) itemFactoryCreate(               \
+             GET_REDIS_GAME_32(x), 1)))                                                                \
+      {                                                                                                \
+            error("Cannot get item '%s'", STRINGIFY(x));                                               \
+            return false;                                                                              \
+      }                                                                                                \
+
+    GET_REDIS_EQUIPMENT(EQSLOT_HAT);
+    GET_REDIS_EQUIPMENT(EQSLOT_HAT_L);
+    GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN1);
+    GET_REDIS_EQUIPMENT(EQSLOT_BODY_ARMOR);
+    GET_REDIS_EQUIPMENT(EQSLOT_GLOVES);
+    GET_REDIS_EQUIPMENT(EQSLOT_BOOTS);
+    GET_REDIS_EQUIPMENT(EQSLOT_HELMET);
+    GET_REDIS_EQUIPMENT(EQSLOT_BRACELET);
+    GET_REDIS_EQUIPMENT(EQSLOT_WEAPON);
+    GET_REDIS_EQUIPMENT(EQSLOT_SHIELD);
+    GET_REDIS_EQUIPMENT(EQSLOT_COSTUME);
+    GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN3);
+    GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN4);
+    GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN5);
+    GET_REDIS_EQUIPMENT(EQSLOT_LEG_ARMOR);
+    GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN6);
+    GET_REDIS_EQUIPMENT(EQSLOT_UNKNOWN7);
+    GET_REDIS_EQUIPMENT(EQSLOT_RING_LEFT);
+    GET_REDIS_EQUIPMENT(EQSLOT_RING_RIGHT);
+    GET_REDIS_EQUIPMENT(EQSLOT_NECKLACE);
+
+    return true;
+}
+
+bool redisGameSessionFromScriptReply(redisReply *reply, GameSession *gameSession, bool *found) {
+
+    *found = false;
+    memset(gameSession, 0, sizeof(*gameSession));
+
+    // [0] = blob, [1] = fields
+    if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2) {
+        error("Abnormal script reply (type %d).", reply->type);
         return false;
     }
 
+    #ifdef __REDIS_GAME_SESSION_BLOB__
+    redisReply *blob = reply->element[0];
+    if (blob->type == REDIS_REPLY_NIL) {
+        // No game session
+        return true;
+    }
+    if (blob->type != REDIS_REPLY_STRING
+    || !(redisGameSessionBlobDecode((uint8_t *) blob->str, blob->len, gameSession, false))) {
+        error("Cannot decode the game session blob.");
+        return false;
+    }
+    #else
+    redisReply *fields = reply->element[1];
+    if (fields->type == REDIS_REPLY_NIL) {
+        // No game session
+        return true;
+    }
+    if (fields->type != REDIS_REPLY_ARRAY
+    || !(redisGameSessionFromHashReply(fields, gameSession))) {
+        error("Cannot get the game session fields.");
+        return false;
+    }
+    #endif
+
+    *found = true;
     return true;
 }
 
+bool redisGetGameSessionBySocketId(Redis *self, RouterId_t routerId, uint8_t *sessionKey, GameSession *gameSession) {
+
+    bool result = false;
+    bool found;
+    redisReply *reply = NULL;
+    RedisGameSessionKey key;
+    char socketKeyStr[128], gameKeyStr[128], blobKeyStr[128], accountIdStr[32];
+    const char *argv[4 + REDIS_SESSION_COUNT];
+    int argc = 0;
+
+    if (!(redisGetGameSessionKeyBySocketId(self, routerId, sessionKey, &key, &found))) {
+        error("Cannot get the socket session of the client.");
+        goto cleanup;
+    }
+    if (!found) {
+        error("The client '%s' doesn't have any socket session.", sessionKey);
+        goto cleanup;
+    }
+
+    // Every key touched by the script is declared, the script checks that the socket session didn't change
+    snprintf(socketKeyStr, sizeof(socketKeyStr), "zone%x:socket%s", routerId, sessionKey);
+    snprintf(gameKeyStr, sizeof(gameKeyStr), REDIS_GAME_SESSION_KEY_FORMAT, (unsigned long long) key.accountId);
+    snprintf(blobKeyStr, sizeof(blobKeyStr), REDIS_GAME_SESSION_BLOB_KEY_FORMAT, (unsigned long long) key.accountId);
+    snprintf(accountIdStr, sizeof(accountIdStr), "%llx", (unsigned long long) key.accountId);
+    argv[argc++] = socketKeyStr;
+    argv[argc++] = gameKeyStr;
+    argv[argc++] = blobKeyStr;
+    argv[argc++] = accountIdStr;
+
+    #ifndef __REDIS_GAME_SESSION_BLOB__
+    for (int i = 0; i < REDIS_SESSION_COUNT; i++) {
+        argv[argc++] = redisGameSessionsStr[i];
+    }
+    #endif
+
+    reply = redisScriptCall(self, REDIS_SCRIPT_GET_SESSION_BY_SOCKET, 3, argc, argv);
+
+    if (!reply) {
+        error("Redis error encountered : The request is invalid.");
+        goto cleanup;
+    }
+
+    switch (reply->type)
+    {
+        case REDIS_REPLY_ERROR:
+            error("Redis error encountered : %s", reply->str);
+            goto cleanup;
+            break;
+
+        case REDIS_REPLY_ARRAY:
+            if (!(redisGameSessionFromScriptReply(reply, gameSession, &found))) {
+                error("Cannot get the game session of the client.");
+                goto cleanup;
+            }
+            if (!found) {
+                error("The client '%s' doesn't have any game session.", sessionKey);
+                goto cleanup;
+            }
+            break;
+
+        default :
+            error("Unexpected Redis status (%d).", reply->type);
+            goto cleanup;
+            break;
+    }
+
+    result = true;
+
+cleanup:
+    redisReplyDestroy(&reply);
+    return result;
+}
+
+bool redisGetGameSessionKeyBySocketId(Redis *self, RouterId_t routerId, uint8_t *sessionKey, RedisGameSessionKey *key, bool *found) {
+
+    bool result = false;
+    redisReply *reply = NULL;
+
+    *found = false;
+
+    reply = redisCommandBin(self,
+        "HMGET zone%x:socket%s "
+        REDIS_SOCKET_SESSION_routerId_str " "
+        REDIS_SOCKET_SESSION_mapId_str " "
+        REDIS_SOCKET_SESSION_accountId_str,
+        routerId, sessionKey
+    );
+
+    if (!reply) {
+        error("Redis error encountered : The request is invalid.");
+        goto cleanup;
+    }
+
+    switch (reply->type)
+    {
+        case REDIS_REPLY_ERROR:
+            error("Redis error encountered : %s", reply->str);
+            goto cleanup;
+            break;
+
+        case REDIS_REPLY_ARRAY:
+            if (reply->elements != 3) {
+                error("Wrong number of elements received.");
+                goto cleanup;
+            }
+            if (redisAnyElementIsNull(reply->element, reply->elements) != -1) {
+                // No socket session
+                break;
+            }
+            key->routerId  = strtoul(reply->element[0]->str, NULL, 16);
+            key->mapId     = strtoul(reply->element[1]->str, NULL, 16);
+            key->accountId = strtoull(reply->element[2]->str, NULL, 16);
+            *found = true;
+            break;
+
+        default :
+            error("Unexpected Redis status (%d).", reply->type);
+            goto cleanup;
+            break;
+    }
+
+    result = true;
+
+cleanup:
+    redisReplyDestroy(&reply);
+    return result;
+}
+
 bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *socketId, GameSession *gameSession) {
 
+    #ifdef __REDIS_GAME_SESSION_BLOB__
+    return redisUpdateGameSessionBlob(self, key, socketId, gameSession);
+    #endif
+
     bool result = true;
     size_t repliesCount = 3;
     redisReply *replies[repliesCount];
@@ -383,12 +547,12 @@ bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *sock
 
     // Account
     replies[0] = redisCommandDbg(self,
-        "HMSET zone%x:map%x:acc%llx"
+        "HMSET " REDIS_GAME_SESSION_KEY_FORMAT
         " " REDIS_SESSION_account_sessionKey_str " %s"
         " " REDIS_SESSION_account_accountName_str " %s"
         " " REDIS_SESSION_account_privilege_str " %x"
         " " REDIS_SESSION_account_commandersCountMax_str " %x",
-        key->routerId, key->mapId, key->accountId,
+        key->accountId,
 
         socketId,
         gameSession->accountSession.accountName,
@@ -399,7 +563,7 @@ bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *sock
     // Commander
     if (commander) {
         replies[1] = redisCommandDbg(self,
-            "HMSET zone%x:map%x:acc%llx"
+            "HMSET " REDIS_GAME_SESSION_KEY_FORMAT
             " " REDIS_SESSION_commander_mapId_str " %x"
             " " REDIS_SESSION_commander_commanderName_str " %s"
             " " REDIS_SESSION_commander_familyName_str " %s"
@@ -427,7 +591,7 @@ bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *sock
             " " REDIS_SESSION_commander_maxSP_str " %x"
             " " REDIS_SESSION_commander_currentStamina_str " %x"
             " " REDIS_SESSION_commander_maxStamina_str " %x",
-            key->routerId, key->mapId, key->accountId,
+            key->accountId,
 
             commander->mapId,
             CHECK_REDIS_EMPTY_STRING(commander->commanderName),
@@ -459,7 +623,7 @@ bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *sock
         );
 
         replies[2] = redisCommandDbg(self,
-            "HMSET zone%x:map%x:acc%llx"
+            "HMSET " REDIS_GAME_SESSION_KEY_FORMAT
             " " REDIS_SESSION_EQSLOT_HAT_str " %x"
             " " REDIS_SESSION_EQSLOT_HAT_L_str " %x"
             " " REDIS_SESSION_EQSLOT_UNKNOWN1_str " %x"
@@ -480,7 +644,7 @@ bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *sock
             " " REDIS_SESSION_EQSLOT_RING_LEFT_str " %x"
             " " REDIS_SESSION_EQSLOT_RING_RIGHT_str " %x"
             " " REDIS_SESSION_EQSLOT_NECKLACE_str " %x"
-            , key->routerId, key->mapId, key->accountId,
+            , key->accountId,
 
             // Equipment
             itemGetId((Item *) commander->inventory.equippedItems[EQSLOT_HAT]),
@@ -536,6 +700,13 @@ bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *sock
         }
     }
 
+    // Map membership
+    if (!(redisMapIndexAddMember(self, key))) {
+        error("Cannot add the game session to its map.");
+        result = false;
+        goto cleanup;
+    }
+
 cleanup:
     for (int i = 0; i < repliesCount; i++) {
         redisReply *reply = replies[i];
@@ -548,16 +719,30 @@ cleanup:
 }
 
 bool redisMoveGameSession(Redis *self, RedisGameSessionKey *from, RedisGameSessionKey *to) {
+
     bool result = true;
     redisReply *reply = NULL;
+    char keys[3][128];
+    char accountId[32];
 
-    reply = redisCommandDbg(self,
-        "RENAME "
-        "zone%x:map%x:acc%llx "
-        "zone%x:map%x:acc%llx",
-        from->routerId, from->mapId, from->accountId,
-          to->routerId,   to->mapId,   to->accountId
-    );
+    if (from->accountId != to->accountId) {
+        error("Cannot move the game session of an account to another account.");
+        return false;
+    }
+
+    // The map membership is moved atomically
+    snprintf(keys[0], sizeof(keys[0]), REDIS_GAME_SESSION_KEY_FORMAT, (unsigned long long) from->accountId);
+    snprintf(keys[1], sizeof(keys[1]), REDIS_MAP_MEMBERS_KEY_FORMAT, from->routerId, from->mapId);
+    snprintf(keys[2], sizeof(keys[2]), REDIS_MAP_MEMBERS_KEY_FORMAT, to->routerId, to->mapId);
+    snprintf(accountId, sizeof(accountId), "%llx", (unsigned long long) from->accountId);
+
+    const char *argv[] = {
+        // Keys
+        keys[0], keys[1], keys[2],
+        // Arguments
+        accountId
+    };
+    reply = redisScriptCall(self, REDIS_SCRIPT_MOVE_SESSION, sizeof_array(keys), sizeof_array(argv), argv);
 
     if (!reply) {
         error("Redis error encountered : The request is invalid.");
@@ -573,8 +758,8 @@ bool redisMoveGameSession(Redis *self, RedisGameSessionKey *from, RedisGameSessi
             goto cleanup;
             break;
 
-        case REDIS_REPLY_STATUS:
-            // info("Redis status : %s", reply->str);
+        case REDIS_REPLY_INTEGER:
+            // Move OK
             break;
 
         default :
@@ -592,151 +777,24 @@ cleanup:
     return result;
 }
 
-zlist_t *redisGetClientsWithinDistance(
-    Redis *self,
-    RouterId_t routerId, MapId_t mapId,
-    PositionXZ *center,
-    float range,
-    char *ignoredSessionKey
-) {
-    bool status = true;
-    zlist_t *clients = NULL;
-    redisReply *reply = NULL;
-    redisReply *posReply = NULL;
-
-    // TODO : Could be better. Don't allocate a new zlist everytime we call this function.
-    // Who got this list then ? The Worker?
-    if (!(clients = zlist_new())) {
-        error("Cannot allocate a new zlist.");
-        status = false;
-        goto cleanup;
-    }
-
-    // Iterate through all the clients
-
-    // TODO : Huge optimization to do here !
-    // It iterates through all the clients of the zone server in the chosen map
-    // It could use a better clustering method, but it should be enough for the moment
-
-    // Start iterating
-    int iterator = 0;
-
-    do {
-        // Get all the accounts within the same area
-        reply = redisCommandDbg(self,
-            "SCAN %d MATCH zone%x:map%x:acc*",
-            iterator, routerId, mapId
-        );
-
-        if (!reply) {
-            error("Redis error encountered : The request is invalid.");
-            status = false;
-            goto cleanup;
-        }
-
-        switch (reply->type) {
-            case REDIS_REPLY_ERROR:
-                error("Redis error encountered : %s", reply->str);
-                status = false;
-                goto cleanup;
-                break;
-
-            case REDIS_REPLY_ARRAY: {
-                // [0] = new iterator
-                iterator = strtoul(reply->element[0]->str, NULL, 10);
-                // [1] = results
-                for (int i = 0; i < reply->element[1]->elements; i++) {
-                    // Get the position of all accounts in the map
-                    posReply = redisCommandDbg(self,
-                        "HMGET %s " REDIS_SESSION_commander_posX_str
-                                " " REDIS_SESSION_commander_posZ_str // Get position
-                                " " REDIS_SESSION_account_sessionKey_str, // SocketKey
-                        reply->element[1]->element[i]->str // account key
-                    );
-
-                    if (!posReply) {
-                        error("Redis error encountered : The request is invalid.");
-                        status = false;
-                        goto cleanup;
-                    }
-
-                    switch (posReply->type) {
-
-                        case REDIS_REPLY_ERROR:
-                            error("Redis error encountered : %s", reply->str);
-                            status = false;
-                            goto cleanup;
-                            break;
-
-                        case REDIS_REPLY_STATUS:
-                            // info("Redis status : %s", reply->str);
-                            break;
-
-                        case REDIS_REPLY_ARRAY: {
-                            if (posReply->elements != 3) {
-                                error("Abnormal number of elements (%d, should be 3).", posReply->elements);
-                                status = false;
-                                goto cleanup;
-                            }
-
-                            // [0] = X, [1] = Z, [2] = socketId
-                            PositionXZ curPpos = {
-                                .x = strtof (posReply->element[0]->str, NULL),
-                                .z = strtof (posReply->element[1]->str, NULL)
-                            };
-                            char *socketId = posReply->element[2]->str;
-
-                            // Check range here
-                            if (mathIsWithin2DManhattanDistance (&curPpos, center, range)) {
-                                // The current client is within the area, add it to the list
-                                // Don't include the ignored socketId
-                                if (!(ignoredSessionKey && strcmp (socketId, ignoredSessionKey) == 0)) {
-                                    zlist_append(clients, strdup(socketId));
-                                }
-                            }
-                        } break;
-
-                        default :
-                            error("Unexpected Redis status. (%d)", reply->type);
-                            status = false;
-                            goto cleanup;
-                            break;
-                    }
-
-                    redisReplyDestroy(&posReply);
-                }
-            } break;
-
-            default :
-                error("Unexpected Redis status. (%d)", reply->type);
-                status = false;
-                goto cleanup;
-                break;
-        }
-
-        redisReplyDestroy(&reply);
-
-    } while (iterator != 0);
-
-cleanup:
-    if (!status) {
-        zlist_destroy (&clients);
-    }
-    redisReplyDestroy(&reply);
-    redisReplyDestroy(&posReply);
-
-    return clients;
-}
-
 bool redisFlushGameSession (Redis *self, RedisGameSessionKey *key) {
 
+    #ifdef __REDIS_GAME_SESSION_BLOB__
+    return redisFlushGameSessionBlob(self, key);
+    #endif
+
     bool result = true;
     redisReply *reply = NULL;
 
+    // Remove the client from its map
+    if (!(redisMapIndexRemove(self, key))) {
+        error("Cannot remove the client from its map.");
+    }
+
     // Delete the key from the Redis
     reply = redisCommandDbg(self,
-        "DEL zone%x:map%x:acc%llx",
-        key->routerId, key->mapId, key->accountId
+        "DEL " REDIS_GAME_SESSION_KEY_FORMAT,
+        key->accountId
     );
 
     if (!reply) {
@@ -20,6 +20,14 @@
 #include "common/redis/redis.h"
 #include "common/session/session.h"
 
+/**
+ * Game sessions are keyed by account only : a session can be read with its account ID alone,
+ * and changing of map or of server doesn't rename it. The map of a session is tracked by the
+ * membership set of that map (see REDIS_MAP_MEMBERS_KEY_FORMAT).
+ */
+#define REDIS_GAME_SESSION_KEY_PREFIX "acc"
+#define REDIS_GAME_SESSION_KEY_FORMAT REDIS_GAME_SESSION_KEY_PREFIX "%llx"
+
 // Game session
 #define REDIS_SESSION_account_accountName_str        "accountName"
 #define REDIS_SESSION_account_sessionKey_str         "sessionKey"
@@ -145,8 +153,10 @@ enum RedisGameSessionFields {
 };
 
 typedef struct {
+    /** Server and map of the session. Only used for the map membership. */
     RouterId_t routerId;
     MapId_t mapId;
+    /** Identifies the session */
     uint64_t accountId;
 } RedisGameSessionKey;
 
@@ -183,6 +193,34 @@ bool redisGetGameSession(Redis *self, RedisGameSessionKey *key, GameSession *gam
  */
 bool redisGetGameSessionBySocketId(Redis *self, RouterId_t routerId, uint8_t *socketId, GameSession *gameSession);
 
+/**
+ * @brief Get the key of the GameSession of a socket session, without creating the socket session
+ * @param self An allocated Redis
+ * @param routerId The router ID containing the target session
+ * @param socketId The socket ID of the target session
+ * @param[out] key The key of the game session
+ * @param[out] found false if the socket session doesn't exist
+ * @return true on success, false otherwise
+ */
+bool redisGetGameSessionKeyBySocketId(Redis *self, RouterId_t routerId, uint8_t *socketId, RedisGameSessionKey *key, bool *found);
+
+/**
+ * @brief Fill a GameSession from the reply of a HMGET of all the RedisGameSessionFields
+ * @param reply The HMGET reply
+ * @param[out] gameSession The output gameSession. A new commander is allocated.
+ * @return true on success, false otherwise
+ */
+bool redisGameSessionFromHashReply(redisReply *reply, GameSession *gameSession);
+
+/**
+ * @brief Fill a GameSession from the {blob, fields} reply of a session script
+ * @param reply The script reply
+ * @param[out] gameSession The output gameSession. A new commander is allocated.
+ * @param[out] found false if the script didn't return any game session
+ * @return true on success, false otherwise
+ */
+bool redisGameSessionFromScriptReply(redisReply *reply, GameSession *gameSession, bool *found);
+
 /**
  * @brief Save an entire GameSession to the Redis server.
  * @param self An allocated Redis instance
@@ -202,27 +240,11 @@ bool redisUpdateGameSession(Redis *self, RedisGameSessionKey *key, uint8_t *sock
 bool redisFlushGameSession(Redis *self, RedisGameSessionKey *key);
 
 /**
- * @brief Move a game session from a server to another
+ * @brief Move a game session to another map or server, in one atomic call
+ *        The session itself isn't renamed : only its map membership changes, in O(1).
  * @param self An initialized Redis instance
- * @param from The source server
- * @param to The destination server
+ * @param from The source map
+ * @param to The destination map. Must have the same accountId than the source.
+ * @return true on success, false otherwise
  */
 bool redisMoveGameSession(Redis *self, RedisGameSessionKey *from, RedisGameSessionKey *to);
-
-/**
- * @brief Return a list of clients into the area of a given position
- * @param self An allocated Worker
- * @param serverId The serverId concerned
- * @param mapId The mapId of the position
- * @param The 2D position of the center of the circle
- * @param range Radius of the circle
- * @param socketIdNoInclude if not NULL, don't include this socketId to the result
- * @return a zlist_t of identity keys
- */
-zlist_t *redisGetClientsWithinDistance(
-    Redis *self,
-    uint16_t serverId,
-    MapId_t mapId,
-    PositionXZ *position,
-    float range,
-    char *socketIdNoInclude);
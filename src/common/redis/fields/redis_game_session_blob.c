@@ -0,0 +1,492 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+
+// ---------- Includes ------------
+#include "redis_game_session_blob.h"
+#include "redis_map_index.h"
+#include "common/packet/packet_stream.h"
+#include "common/actor/item/item_factory.h"
+
+
+// ------ Structure declaration -------
+
+
+// ------ Static declaration -------
+/** Little-endian writers, independent of the host byte order */
+static void blobWriteU8(PacketStream *stream, uint8_t value);
+static void blobWriteU16(PacketStream *stream, uint16_t value);
+static void blobWriteU32(PacketStream *stream, uint32_t value);
+static void blobWriteU64(PacketStream *stream, uint64_t value);
+static void blobWriteFloat(PacketStream *stream, float value);
+
+/** Little-endian readers, independent of the host byte order */
+static uint8_t blobReadU8(PacketStream *stream);
+static uint16_t blobReadU16(PacketStream *stream);
+static uint32_t blobReadU32(PacketStream *stream);
+static uint64_t blobReadU64(PacketStream *stream);
+static float blobReadFloat(PacketStream *stream);
+
+/**
+ * @brief Check the reply of a pipelined write command
+ * @param reply The reply to check
+ * @param expectedType The reply type expected
+ * @return true on success, false otherwise
+ */
+static bool redisGameSessionBlobCheckReply(redisReply *reply, int expectedType);
+
+
+// ------ Extern functions implementation -------
+
+size_t redisGameSessionBlobEncode(GameSession *gameSession, uint8_t *socketId, uint8_t *blob) {
+
+    PacketStream stream;
+    Commander *commander = gameSession->commanderSession.currentCommander;
+    uint16_t payloadSize = REDIS_GAME_SESSION_BLOB_ACCOUNT_SIZE;
+
+    if (commander) {
+        payloadSize += REDIS_GAME_SESSION_BLOB_COMMANDER_SIZE + REDIS_GAME_SESSION_BLOB_EQUIPMENT_SIZE;
+    }
+
+    packetStreamInit(&stream, blob, REDIS_GAME_SESSION_BLOB_MAX_SIZE);
+
+    // Header
+    blobWriteU32(&stream, REDIS_GAME_SESSION_BLOB_MAGIC);
+    blobWriteU16(&stream, REDIS_GAME_SESSION_BLOB_VERSION);
+    blobWriteU16(&stream, payloadSize);
+    blobWriteU8(&stream, commander ? REDIS_GAME_SESSION_BLOB_HAS_COMMANDER : 0);
+
+    // Account
+    AccountSession *accountSession = &gameSession->accountSession;
+    packetStreamAppend(&stream, accountSession->accountName, sizeof(accountSession->accountName));
+    packetStreamAppend(&stream, socketId, SOCKET_SESSION_ID_SIZE);
+    blobWriteU8(&stream, accountSession->privilege);
+    blobWriteU32(&stream, accountSession->commandersCountMax);
+
+    if (commander) {
+        // Commander
+        packetStreamAppend(&stream, commander->commanderName, sizeof(commander->commanderName));
+        packetStreamAppend(&stream, commander->familyName, sizeof(commander->familyName));
+        blobWriteU64(&stream, commander->accountId);
+        blobWriteU16(&stream, commander->classId);
+        blobWriteU16(&stream, commander->jobId);
+        blobWriteU8(&stream, commander->gender);
+        blobWriteU32(&stream, commander->level);
+        blobWriteU8(&stream, commander->hairId);
+        blobWriteU16(&stream, commander->pose);
+        blobWriteU16(&stream, commander->mapId);
+        blobWriteFloat(&stream, commander->pos.x);
+        blobWriteFloat(&stream, commander->pos.y);
+        blobWriteFloat(&stream, commander->pos.z);
+        blobWriteFloat(&stream, commander->barrackPos.x);
+        blobWriteFloat(&stream, commander->barrackPos.y);
+        blobWriteFloat(&stream, commander->barrackPos.z);
+        blobWriteU32(&stream, commander->currentXP);
+        blobWriteU32(&stream, commander->maxXP);
+        blobWriteU32(&stream, commander->pcId);
+        blobWriteU64(&stream, commander->socialInfoId);
+        blobWriteU64(&stream, commander->commanderId);
+        blobWriteU32(&stream, commander->currentHP);
+        blobWriteU32(&stream, commander->maxHP);
+        blobWriteU16(&stream, commander->currentSP);
+        blobWriteU16(&stream, commander->maxSP);
+        blobWriteU32(&stream, commander->currentStamina);
+        blobWriteU32(&stream, commander->maxStamina);
+
+        // Equipment
+        for (int slot = 0; slot < EQSLOT_COUNT; slot++) {
+            blobWriteU32(&stream, itemGetId((Item *) commander->inventory.equippedItems[slot]));
+        }
+    }
+
+    return packetStreamGetSize(&stream);
+}
+
+bool redisGameSessionBlobDecode(uint8_t *blob, size_t blobSize, GameSession *gameSession, bool accountOnly) {
+
+    PacketStream stream;
+    Commander *commander = NULL;
+
+    if (blobSize < REDIS_GAME_SESSION_BLOB_HEADER_SIZE + REDIS_GAME_SESSION_BLOB_ACCOUNT_SIZE) {
+        error("The game session blob is too small (%d bytes).", blobSize);
+        goto cleanup;
+    }
+
+    packetStreamInit(&stream, blob, blobSize);
+
+    // Header
+    uint32_t magic = blobReadU32(&stream);
+    uint16_t version = blobReadU16(&stream);
+    uint16_t payloadSize = blobReadU16(&stream);
+    uint8_t flags = blobReadU8(&stream);
+
+    if (magic != REDIS_GAME_SESSION_BLOB_MAGIC) {
+        error("Wrong game session blob magic (%x).", magic);
+        goto cleanup;
+    }
+
+    if (version != REDIS_GAME_SESSION_BLOB_VERSION) {
+        error("Unsupported game session blob version (%d, expected %d).", version, REDIS_GAME_SESSION_BLOB_VERSION);
+        goto cleanup;
+    }
+
+    size_t expectedSize = REDIS_GAME_SESSION_BLOB_ACCOUNT_SIZE;
+    if (flags & REDIS_GAME_SESSION_BLOB_HAS_COMMANDER) {
+        expectedSize += REDIS_GAME_SESSION_BLOB_COMMANDER_SIZE + REDIS_GAME_SESSION_BLOB_EQUIPMENT_SIZE;
+    }
+
+    if (payloadSize != expectedSize || blobSize != REDIS_GAME_SESSION_BLOB_HEADER_SIZE + expectedSize) {
+        error("Corrupted game session blob (payload = %d bytes, blob = %d bytes).", payloadSize, blobSize);
+        goto cleanup;
+    }
+
+    // Account
+    AccountSession *accountSession = &gameSession->accountSession;
+    packetStreamGet(&stream, accountSession->accountName, sizeof(accountSession->accountName));
+    packetStreamGet(&stream, accountSession->sessionKey, sizeof(accountSession->sessionKey));
+    accountSession->privilege = blobReadU8(&stream);
+    accountSession->commandersCountMax = blobReadU32(&stream);
+
+    if (accountOnly) {
+        return true;
+    }
+
+    if (!(flags & REDIS_GAME_SESSION_BLOB_HAS_COMMANDER)) {
+        error("The game session blob doesn't contain any commander.");
+        goto cleanup;
+    }
+
+    // Commander
+    commander = commanderNew();
+    packetStreamGet(&stream, commander->commanderName, sizeof(commander->commanderName));
+    packetStreamGet(&stream, commander->familyName, sizeof(commander->familyName));
+    commander->accountId = blobReadU64(&stream);
+    commander->classId = blobReadU16(&stream);
+    commander->jobId = blobReadU16(&stream);
+    commander->gender = blobReadU8(&stream);
+    commander->level = blobReadU32(&stream);
+    commander->hairId = blobReadU8(&stream);
+    commander->pose = blobReadU16(&stream);
+    commander->mapId = blobReadU16(&stream);
+    commander->pos.x = blobReadFloat(&stream);
+    commander->pos.y = blobReadFloat(&stream);
+    commander->pos.z = blobReadFloat(&stream);
+    commander->barrackPos.x = blobReadFloat(&stream);
+    commander->barrackPos.y = blobReadFloat(&stream);
+    commander->barrackPos.z = blobReadFloat(&stream);
+    commander->currentXP = blobReadU32(&stream);
+    commander->maxXP = blobReadU32(&stream);
+    commander->pcId = blobReadU32(&stream);
+    commander->socialInfoId = blobReadU64(&stream);
+    commander->commanderId = blobReadU64(&stream);
+    commander->currentHP = blobReadU32(&stream);
+    commander->maxHP = blobReadU32(&stream);
+    commander->currentSP = blobReadU16(&stream);
+    commander->maxSP = blobReadU16(&stream);
+    commander->currentStamina = blobReadU32(&stream);
+    commander->maxStamina = blobReadU32(&stream);
+
+    // Equipment
+    for (int slot = 0; slot < EQSLOT_COUNT; slot++) {
+        ItemId_t itemId = blobReadU32(&stream);
+        if (!(commander->inventory.equippedItems[slot] = (ItemEquipable *) itemFactoryCreate(itemId, 1))) {
+            error("Cannot get item '%d' in slot %d.", itemId, slot);
+            goto cleanup;
+        }
+    }
+
+    gameSession->commanderSession.currentCommander = commander;
+    return true;
+
+cleanup:
+    commanderDestroy(&commander);
+    return false;
+}
+
+bool redisGetAccountSessionBlob(Redis *self, RedisAccountSessionKey *key, AccountSession *accountSession) {
+
+    bool result = false;
+    redisReply *reply = NULL;
+    GameSession gameSession;
+
+    reply = redisCommandBin(self,
+        "GET " REDIS_GAME_SESSION_BLOB_KEY_FORMAT,
+        key->accountId
+    );
+
+    if (!reply) {
+        error("Redis error encountered : The request is invalid.");
+        goto cleanup;
+    }
+
+    switch (reply->type)
+    {
+        case REDIS_REPLY_ERROR:
+            error("Redis error encountered : %s", reply->str);
+            goto cleanup;
+            break;
+
+        case REDIS_REPLY_STRING:
+            memset(&gameSession, 0, sizeof(gameSession));
+            if (!(redisGameSessionBlobDecode((uint8_t *) reply->str, reply->len, &gameSession, true))) {
+                error("Cannot decode the account session blob.");
+                goto cleanup;
+            }
+            memcpy(accountSession->accountName, gameSession.accountSession.accountName, sizeof(accountSession->accountName));
+            memcpy(accountSession->sessionKey, gameSession.accountSession.sessionKey, sizeof(accountSession->sessionKey));
+            accountSession->privilege = gameSession.accountSession.privilege;
+            accountSession->commandersCountMax = gameSession.accountSession.commandersCountMax;
+        break;
+
+        default :
+            error("Unexpected Redis status (%d).", reply->type);
+            goto cleanup;
+            break;
+    }
+
+    result = true;
+
+cleanup:
+    if (reply) {
+        redisReplyDestroy(&reply);
+    }
+
+    return result;
+}
+
+bool redisGetGameSessionBlob(Redis *self, RedisGameSessionKey *key, GameSession *gameSession) {
+
+    memset(gameSession, 0, sizeof(*gameSession));
+
+    bool result = false;
+    redisReply *reply = NULL;
+
+    reply = redisCommandBin(self,
+        "GET " REDIS_GAME_SESSION_BLOB_KEY_FORMAT,
+        key->accountId
+    );
+
+    if (!reply) {
+        error("Redis error encountered : The request is invalid.");
+        goto cleanup;
+    }
+
+    switch (reply->type)
+    {
+        case REDIS_REPLY_ERROR:
+            error("Redis error encountered : %s", reply->str);
+            goto cleanup;
+            break;
+
+        case REDIS_REPLY_STRING:
+            if (!(redisGameSessionBlobDecode((uint8_t *) reply->str, reply->len, gameSession, false))) {
+                error("Cannot decode the game session blob.");
+                goto cleanup;
+            }
+        break;
+
+        default :
+            error("Unexpected Redis status (%d).", reply->type);
+            goto cleanup;
+            break;
+    }
+
+    result = true;
+
+cleanup:
+    if (reply) {
+        redisReplyDestroy(&reply);
+    }
+
+    return result;
+}
+
+bool redisUpdateGameSessionBlob(Redis *self, RedisGameSessionKey *key, uint8_t *socketId, GameSession *gameSession) {
+
+    bool result = true;
+    uint8_t blob[REDIS_GAME_SESSION_BLOB_MAX_SIZE];
+    size_t blobSize;
+    Commander *commander = gameSession->commanderSession.currentCommander;
+    size_t repliesCount = 0;
+    int expectedTypes[3];
+
+    blobSize = redisGameSessionBlobEncode(gameSession, socketId, blob);
+
+    // All the commands are sent in the same round trip
+    if (!(redisPipelineAppend(self,
+        "SET " REDIS_GAME_SESSION_BLOB_KEY_FORMAT " %b",
+        key->accountId,
+        blob, blobSize)))
+    {
+        error("Cannot queue the game session blob.");
+        return false;
+    }
+    expectedTypes[repliesCount++] = REDIS_REPLY_STATUS;
+
+    // Queryable fields
+    if (commander) {
+        result = redisPipelineAppend(self,
+            "HMSET " REDIS_GAME_SESSION_KEY_FORMAT
+            " " REDIS_SESSION_account_sessionKey_str " %s"
+            " " REDIS_SESSION_commander_pcId_str " %x"
+            " " REDIS_SESSION_commander_mapId_str " %x"
+            " " REDIS_SESSION_commander_posX_str " %f"
+            " " REDIS_SESSION_commander_posY_str " %f"
+            " " REDIS_SESSION_commander_posZ_str " %f",
+            key->accountId,
+            socketId,
+            commander->pcId,
+            commander->mapId,
+            commander->pos.x,
+            commander->pos.y,
+            commander->pos.z
+        );
+    } else {
+        result = redisPipelineAppend(self,
+            "HMSET " REDIS_GAME_SESSION_KEY_FORMAT
+            " " REDIS_SESSION_account_sessionKey_str " %s",
+            key->accountId,
+            socketId
+        );
+    }
+    if (result) {
+        expectedTypes[repliesCount++] = REDIS_REPLY_STATUS;
+    } else {
+        error("Cannot queue the game session queryable fields.");
+    }
+
+    // Map membership
+    if (redisPipelineAppend(self,
+        "SADD " REDIS_MAP_MEMBERS_KEY_FORMAT " %llx",
+        key->routerId, key->mapId, key->accountId))
+    {
+        expectedTypes[repliesCount++] = REDIS_REPLY_INTEGER;
+    } else {
+        error("Cannot queue the map membership update.");
+        result = false;
+    }
+
+    // Always consume all the replies queued, so the connection stays synchronized
+    for (int i = 0; i < repliesCount; i++) {
+        redisReply *reply = redisPipelineGetReply(self);
+        if (!(redisGameSessionBlobCheckReply(reply, expectedTypes[i]))) {
+            result = false;
+        }
+        redisReplyDestroy(&reply);
+    }
+
+    return result;
+}
+
+bool redisFlushGameSessionBlob(Redis *self, RedisGameSessionKey *key) {
+
+    bool result = true;
+    redisReply *reply = NULL;
+
+    // Remove the client from its map
+    if (!(redisMapIndexRemove(self, key))) {
+        error("Cannot remove the client from its map.");
+    }
+
+    // Delete both keys from the Redis
+    reply = redisCommandBin(self,
+        "DEL " REDIS_GAME_SESSION_BLOB_KEY_FORMAT " " REDIS_GAME_SESSION_KEY_FORMAT,
+        key->accountId, key->accountId
+    );
+
+    if (!(redisGameSessionBlobCheckReply(reply, REDIS_REPLY_INTEGER))) {
+        result = false;
+    }
+
+    redisReplyDestroy(&reply);
+
+    return result;
+}
+
+// ------ Static functions implementation -------
+
+static bool redisGameSessionBlobCheckReply(redisReply *reply, int expectedType) {
+
+    if (!reply) {
+        error("Redis error encountered : The request is invalid.");
+        return false;
+    }
+
+    if (reply->type == REDIS_REPLY_ERROR) {
+        error("Redis error encountered : %s", reply->str);
+        return false;
+    }
+
+    if (reply->type != expectedType) {
+        error("Unexpected Redis status. (%d)", reply->type);
+        return false;
+    }
+
+    return true;
+}
+
+static void blobWriteU8(PacketStream *stream, uint8_t value) {
+    packetStreamAppend(stream, &value, sizeof(value));
+}
+
+static void blobWriteU16(PacketStream *stream, uint16_t value) {
+    uint8_t bytes[2] = {value, value >> 8};
+    packetStreamAppend(stream, bytes, sizeof(bytes));
+}
+
+static void blobWriteU32(PacketStream *stream, uint32_t value) {
+    uint8_t bytes[4] = {value, value >> 8, value >> 16, value >> 24};
+    packetStreamAppend(stream, bytes, sizeof(bytes));
+}
+
+static void blobWriteU64(PacketStream *stream, uint64_t value) {
+    blobWriteU32(stream, value);
+    blobWriteU32(stream, value >> 32);
+}
+
+static void blobWriteFloat(PacketStream *stream, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    blobWriteU32(stream, bits);
+}
+
+static uint8_t blobReadU8(PacketStream *stream) {
+    uint8_t value = 0;
+    packetStreamGet(stream, &value, sizeof(value));
+    return value;
+}
+
+static uint16_t blobReadU16(PacketStream *stream) {
+    uint8_t bytes[2] = {0};
+    packetStreamGet(stream, bytes, sizeof(bytes));
+    return bytes[0] | (bytes[1] << 8);
+}
+
+static uint32_t blobReadU32(PacketStream *stream) {
+    uint8_t bytes[4] = {0};
+    packetStreamGet(stream, bytes, sizeof(bytes));
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+static uint64_t blobReadU64(PacketStream *stream) {
+    uint64_t low = blobReadU32(stream);
+    uint64_t high = blobReadU32(stream);
+    return low | (high << 32);
+}
+
+static float blobReadFloat(PacketStream *stream) {
+    uint32_t bits = blobReadU32(stream);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
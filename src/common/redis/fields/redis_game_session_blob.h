@@ -0,0 +1,105 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file redis_game_session_blob.h
+ * @brief Packed binary storage of the GameSession in Redis.
+ *
+ * The whole GameSession is stored as one versioned, fixed-layout little-endian value
+ * under blob%llx, and loaded / saved with a single GET / SET.
+ * The fields needed by other processes (sessionKey, pcId, mapId, position) are mirrored
+ * in a small hash under the usual acc%llx key.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+#include "R1EMU.h"
+#include "common/redis/redis.h"
+#include "common/redis/fields/redis_game_session.h"
+
+/** Key of the blob of an account */
+#define REDIS_GAME_SESSION_BLOB_KEY_PREFIX "blob"
+#define REDIS_GAME_SESSION_BLOB_KEY_FORMAT REDIS_GAME_SESSION_BLOB_KEY_PREFIX "%llx"
+
+/** Blob identification */
+#define REDIS_GAME_SESSION_BLOB_MAGIC   0x53475231 // "1RGS"
+#define REDIS_GAME_SESSION_BLOB_VERSION 1
+
+/** Blob flags */
+#define REDIS_GAME_SESSION_BLOB_HAS_COMMANDER (1 << 0)
+
+/** Sizes of the blob sections, in bytes. Keep them synchronized with the encoder. */
+#define REDIS_GAME_SESSION_BLOB_HEADER_SIZE    (4 + 2 + 2 + 1)
+#define REDIS_GAME_SESSION_BLOB_ACCOUNT_SIZE   (ACCOUNT_SESSION_ACCOUNT_NAME_MAXSIZE + SOCKET_SESSION_ID_SIZE + 1 + 4)
+#define REDIS_GAME_SESSION_BLOB_COMMANDER_SIZE (COMMANDER_NAME_SIZE + 1 + COMMANDER_FAMILY_NAME_SIZE \
+                                                + 8 + 2 + 2 + 1 + 4 + 1 + 2 + 2 + 4*3 + 4*3 \
+                                                + 4 + 4 + 4 + 8 + 8 + 4 + 4 + 2 + 2 + 4 + 4)
+#define REDIS_GAME_SESSION_BLOB_EQUIPMENT_SIZE (EQSLOT_COUNT * 4)
+
+#define REDIS_GAME_SESSION_BLOB_MAX_SIZE (REDIS_GAME_SESSION_BLOB_HEADER_SIZE \
+                                        + REDIS_GAME_SESSION_BLOB_ACCOUNT_SIZE \
+                                        + REDIS_GAME_SESSION_BLOB_COMMANDER_SIZE \
+                                        + REDIS_GAME_SESSION_BLOB_EQUIPMENT_SIZE)
+
+/**
+ * @brief Serialize a GameSession into a blob
+ * @param gameSession The GameSession to serialize
+ * @param socketId The socketId linked with the Game Session
+ * @param[out] blob The output buffer, at least REDIS_GAME_SESSION_BLOB_MAX_SIZE bytes long
+ * @return the size of the blob written
+ */
+size_t redisGameSessionBlobEncode(GameSession *gameSession, uint8_t *socketId, uint8_t *blob);
+
+/**
+ * @brief Unserialize a blob into a GameSession
+ * @param blob The blob to unserialize
+ * @param blobSize The size of the blob
+ * @param[out] gameSession The output GameSession. A new commander is allocated if the blob contains one.
+ * @param accountOnly If true, only the account section is unserialized
+ * @return true on success, false otherwise
+ */
+bool redisGameSessionBlobDecode(uint8_t *blob, size_t blobSize, GameSession *gameSession, bool accountOnly);
+
+/**
+ * @brief Get the AccountSession from the blob storage
+ * @param self An allocated Redis
+ * @param key The AccountSession key
+ * @param[out] accountSession The output AccountSession
+ * @return true on success, false otherwise
+ */
+bool redisGetAccountSessionBlob(Redis *self, RedisAccountSessionKey *key, AccountSession *accountSession);
+
+/**
+ * @brief Get the GameSession from the blob storage with a single GET
+ * @param self An allocated Redis
+ * @param key The GameSession key
+ * @param[out] gameSession The output gameSession
+ * @return true on success, false otherwise
+ */
+bool redisGetGameSessionBlob(Redis *self, RedisGameSessionKey *key, GameSession *gameSession);
+
+/**
+ * @brief Save an entire GameSession to the blob storage, and refresh its queryable fields
+ * @param self An allocated Redis instance
+ * @param key The GameSession key
+ * @param socketId The socketId linked with the Game Session
+ * @param gameSession The Game Session to save
+ * @return true on success, false otherwise
+ */
+bool redisUpdateGameSessionBlob(Redis *self, RedisGameSessionKey *key, uint8_t *socketId, GameSession *gameSession);
+
+/**
+ * @brief Flush a blob GameSession and its queryable fields
+ * @param self An allocated Redis instance
+ * @param key The GameSession key
+ * @return true on success, false otherwise
+ */
+bool redisFlushGameSessionBlob(Redis *self, RedisGameSessionKey *key);
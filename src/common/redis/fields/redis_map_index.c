@@ -0,0 +1,92 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+
+// ---------- Includes ------------
+#include "redis_map_index.h"
+
+
+// ------ Structure declaration -------
+
+
+// ------ Static declaration -------
+/**
+ * @brief Check the reply of a membership write command
+ * @param reply The reply to check
+ * @return true on success, false otherwise
+ */
+static bool redisMapIndexCheckReply(redisReply *reply);
+
+
+// ------ Extern functions implementation -------
+
+bool redisMapIndexAddMember(Redis *self, RedisGameSessionKey *key) {
+
+    bool result;
+    redisReply *reply = NULL;
+
+    reply = redisCommandBin(self,
+        "SADD " REDIS_MAP_MEMBERS_KEY_FORMAT " %llx",
+        key->routerId, key->mapId, key->accountId
+    );
+
+    result = redisMapIndexCheckReply(reply);
+    redisReplyDestroy(&reply);
+
+    return result;
+}
+
+bool redisMapIndexRemove(Redis *self, RedisGameSessionKey *key) {
+
+    bool result;
+    redisReply *reply = NULL;
+
+    reply = redisCommandBin(self,
+        "SREM " REDIS_MAP_MEMBERS_KEY_FORMAT " %llx",
+        key->routerId, key->mapId, key->accountId
+    );
+
+    result = redisMapIndexCheckReply(reply);
+    redisReplyDestroy(&reply);
+
+    return result;
+}
+
+// ------ Static functions implementation -------
+
+static bool redisMapIndexCheckReply(redisReply *reply) {
+
+    if (!reply) {
+        error("Redis error encountered : The request is invalid.");
+        return false;
+    }
+
+    switch (reply->type)
+    {
+        case REDIS_REPLY_ERROR:
+            error("Redis error encountered : %s", reply->str);
+            return false;
+            break;
+
+        case REDIS_REPLY_INTEGER:
+            // Ok
+            break;
+
+        default :
+            error("Unexpected Redis status. (%d)", reply->type);
+            return false;
+            break;
+    }
+
+    return true;
+}
@@ -0,0 +1,44 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file redis_map_index.h
+ * @brief Per-map set of the accounts in Redis.
+ *
+ * Each map owns a set (zone%x:map%x:members) whose members are the account IDs of its game sessions.
+ * It tells which server owns a game session, the range queries are answered by the EventServer grid.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+#include "R1EMU.h"
+#include "common/redis/redis.h"
+#include "common/redis/fields/redis_game_session.h"
+
+/** Key of the set of the accounts of a map */
+#define REDIS_MAP_MEMBERS_KEY_FORMAT "zone%x:map%x:members"
+
+/**
+ * @brief Add a game session to the members of its map
+ * @param self An allocated Redis instance
+ * @param key The game session key
+ * @return true on success, false otherwise
+ */
+bool redisMapIndexAddMember(Redis *self, RedisGameSessionKey *key);
+
+/**
+ * @brief Remove a game session from the members of its map
+ * @param self An allocated Redis instance
+ * @param key The game session key
+ * @return true on success, false otherwise
+ */
+bool redisMapIndexRemove(Redis *self, RedisGameSessionKey *key);
+
@@ -16,6 +16,9 @@
 #include "redis_session.h"
 #include "redis_socket_session.h"
 #include "redis_game_session.h"
+#include "redis_game_session_blob.h"
+#include "redis_map_index.h"
+#include "common/redis/redis_scripts.h"
 
 
 // ------ Structure declaration -------
@@ -51,36 +54,98 @@ bool redisUpdateSession (Redis *self, Session *session) {
 }
 
 bool redisFlushSession (Redis *self, RedisSessionKey *key) {
+    return redisGetAndFlushSession(self, key, NULL, NULL);
+}
+
+bool redisGetAndFlushSession(Redis *self, RedisSessionKey *key, GameSession *gameSession, bool *found) {
 
+    bool result = false;
+    redisReply *reply = NULL;
     RedisSocketSessionKey *socketKey = &key->socketKey;
-    // Retrieve the entire SocketSession
-    SocketSession socketSession;
+    RedisGameSessionKey gameKey;
+    bool socketFound;
+    char socketKeyStr[128], membersKeyStr[128], gameKeyStr[128], blobKeyStr[128];
+    char routerIdStr[16], mapIdStr[16], accountIdStr[32];
+    const char *argv[7 + REDIS_SESSION_COUNT];
+    int argc = 0;
+
+    if (found) {
+        *found = false;
+    }
 
-    if (!(redisGetSocketSession(self, socketKey, &socketSession))) {
-        error("Cannot get the SocketSession for %s.", socketKey->sessionKey);
-        return false;
+    if (!(redisGetGameSessionKeyBySocketId(self, socketKey->routerId, socketKey->sessionKey, &gameKey, &socketFound))) {
+        error("Cannot get the socket session of '%s'.", socketKey->sessionKey);
+        goto cleanup;
+    }
+    if (!socketFound) {
+        // Nothing to flush
+        result = true;
+        goto cleanup;
     }
 
-    // Flush the game session
-    RedisGameSessionKey gameKey = {
-        .routerId = socketSession.routerId,
-        .mapId = socketSession.mapId,
-        .accountId = socketSession.accountId
-    };
-    if (!(redisFlushGameSession (self, &gameKey))) {
-        error("Cannot flush the Game Session associated with the Socket Session.");
-        return false;
+    // Every key touched by the script is declared, the script checks that the socket session didn't change
+    snprintf(socketKeyStr, sizeof(socketKeyStr), "zone%x:socket%s", socketKey->routerId, socketKey->sessionKey);
+    snprintf(membersKeyStr, sizeof(membersKeyStr), REDIS_MAP_MEMBERS_KEY_FORMAT, gameKey.routerId, gameKey.mapId);
+    snprintf(gameKeyStr, sizeof(gameKeyStr), REDIS_GAME_SESSION_KEY_FORMAT, (unsigned long long) gameKey.accountId);
+    snprintf(blobKeyStr, sizeof(blobKeyStr), REDIS_GAME_SESSION_BLOB_KEY_FORMAT, (unsigned long long) gameKey.accountId);
+    snprintf(routerIdStr, sizeof(routerIdStr), "%x", gameKey.routerId);
+    snprintf(mapIdStr, sizeof(mapIdStr), "%x", gameKey.mapId);
+    snprintf(accountIdStr, sizeof(accountIdStr), "%llx", (unsigned long long) gameKey.accountId);
+    argv[argc++] = socketKeyStr;
+    argv[argc++] = membersKeyStr;
+    argv[argc++] = gameKeyStr;
+    argv[argc++] = blobKeyStr;
+    argv[argc++] = routerIdStr;
+    argv[argc++] = mapIdStr;
+    argv[argc++] = accountIdStr;
+
+    #ifndef __REDIS_GAME_SESSION_BLOB__
+    // Fields of the game session to return
+    if (gameSession) {
+        for (int i = 0; i < REDIS_SESSION_COUNT; i++) {
+            argv[argc++] = redisGameSessionsStr[i];
+        }
     }
+    #endif
 
-    // Flush the socket session
-    if (!(redisFlushSocketSession (self, socketKey))) {
-        error("Cannot flush the Game Session associated with the Socket Session.");
-        return false;
+    reply = redisScriptCall(self, REDIS_SCRIPT_FLUSH_SESSION, 4, argc, argv);
+
+    if (!reply) {
+        error("Redis error encountered : The request is invalid.");
+        goto cleanup;
     }
 
-    return true;
-}
+    switch (reply->type)
+    {
+        case REDIS_REPLY_ERROR:
+            error("Redis error encountered : %s", reply->str);
+            goto cleanup;
+            break;
+
+        case REDIS_REPLY_ARRAY:
+            if (!gameSession) {
+                // Flush only
+                break;
+            }
+
+            if (!(redisGameSessionFromScriptReply(reply, gameSession, found))) {
+                error("Cannot get the game session of '%s'.", socketKey->sessionKey);
+                goto cleanup;
+            }
+            break;
+
+        default :
+            error("Unexpected Redis status (%d).", reply->type);
+            goto cleanup;
+            break;
+    }
 
+    result = true;
+
+cleanup:
+    redisReplyDestroy(&reply);
+    return result;
+}
 
 /*
 bool redisGetSession (Redis *self, RedisSessionKey *key, Session *session) {
@@ -42,6 +42,17 @@ bool redisUpdateSession(Redis *redis,Session *session);
  */
 bool redisFlushSession(Redis *self,RedisSessionKey *key);
 
+/**
+ * @brief Get the GameSession of a Session, and flush the entire Session, in one atomic call
+ *        If the GameSession has been moved to another map or server meanwhile, only the socket session is flushed.
+ * @param self An allocated Redis instance
+ * @param key The key of the Session
+ * @param[out] gameSession The flushed GameSession. If NULL, the session is only flushed.
+ * @param[out] found false if no GameSession has been flushed. Can be NULL if gameSession is NULL.
+ * @return true on success, false otherwise
+ */
+bool redisGetAndFlushSession(Redis *self, RedisSessionKey *key, GameSession *gameSession, bool *found);
+
 
 /**
  * @brief Request the session from a SessionKey
@@ -14,6 +14,8 @@
 
 // ---------- Includes ------------
 #include "redis.h"
+#include "redis_pool.h"
+#include "redis_scripts.h"
 
 // GameSession Fields
 #include "fields/redis_game_session.h"
@@ -27,12 +29,37 @@ struct Redis
     /** Start up information about the Redis connection */
     RedisInfo info;
 
-    /** Redis context, handle of the connection to the redis server */
-    redisContext *context;
+    /** Connections pool shared by the process */
+    RedisPool *pool;
+
+    /** Connection reserved while pipelined replies are pending */
+    RedisConnection *pipeline;
+    size_t pipelineCount;
 };
 
 
 // ------ Static declaration -------
+/** Commands that must not be sent twice if the connection is lost while waiting for their reply */
+static const char *redisNotReplayableCommands[] = {
+    "RENAME", "INCR", "INCRBY", "DECR", "DECRBY", "LPUSH", "RPUSH", "EVAL", "EVALSHA", NULL
+};
+
+/**
+ * @brief Tells if a command can be sent again after a connection loss
+ * @param command The command or its format
+ * @return true if the command can be replayed, false otherwise
+ */
+static bool redisCommandIsReplayable(const char *command);
+
+/**
+ * @brief Send a command through a connection of the pool, and replay it after reconnection if needed
+ * @param self An allocated Redis instance
+ * @param format the format of the command
+ * @param args The values of the command
+ * @return A redisReply
+ */
+static redisReply *redisvCommandPooled(Redis *self, const char *format, va_list args);
+static redisReply *redisCommandPooled(Redis *self, const char *format, ...);
 
 // ------ Extern function implementation -------
 
@@ -55,15 +82,16 @@ Redis *redisNew(RedisInfo *info) {
 
 bool redisInit(Redis *self, RedisInfo *info) {
 
-    redisInfoInit(&self->info, info->hostname, info->port);
+    redisInfoInit(&self->info, info->hostname, info->port, info->poolSize);
 
     return true;
 }
 
-bool redisInfoInit(RedisInfo *self, char *hostname, int port) {
+bool redisInfoInit(RedisInfo *self, char *hostname, int port, int poolSize) {
 
     self->hostname = strdup(hostname);
     self->port = port;
+    self->poolSize = poolSize;
 
     return true;
 }
@@ -74,16 +102,22 @@ bool redisConnection(Redis *self) {
 
     info("Connecting to the Redis Server (%s:%d)...", info->hostname, info->port);
 
-    while (1) {
-        self->context = redisConnectWithTimeout (info->hostname, info->port, (struct timeval) {.tv_sec = 3, .tv_usec = 0});
+    if (!(self->pool = redisPoolShared(info))) {
+        error("Cannot get the Redis connections pool.");
+        return false;
+    }
 
-        if (self->context != NULL && self->context->err) {
-            warning("Redis server not detected (%s)... Retrying in 3 seconds.", self->context->errstr);
-            zclock_sleep(3000);
-        } else {
-            // Connection OK
-            break;
-        }
+    // Make sure the server is reachable before going further
+    RedisConnection *connection;
+    if (!(connection = redisPoolAcquire(self->pool))) {
+        error("Cannot reach the Redis server.");
+        return false;
+    }
+    redisPoolRelease(self->pool, connection);
+
+    if (!(redisScriptsLoad(self))) {
+        error("Cannot load the Redis scripts.");
+        return false;
     }
 
     info("Connected to the Redis Server !");
@@ -159,7 +193,103 @@ redisReply *redisCommandDbg(Redis *self, char * format, ...) {
     va_end(args);
 
     //special("%s", buffer);
-    return redisCommand(self->context, buffer);
+    return redisCommandPooled(self, buffer);
+}
+
+redisReply *redisCommandBin(Redis *self, const char *format, ...) {
+
+    redisReply *reply = NULL;
+    va_list args;
+
+    va_start(args, format);
+        reply = redisvCommandPooled(self, format, args);
+    va_end(args);
+
+    return reply;
+}
+
+redisReply *redisCommandArgvBin(Redis *self, int argc, const char **argv, const size_t *argvlen) {
+
+    redisReply *reply = NULL;
+    RedisConnection *connection;
+
+    if (!(connection = redisPoolAcquire(self->pool))) {
+        return NULL;
+    }
+
+    reply = redisCommandArgv(connection->context, argc, argv, argvlen);
+
+    if (!reply && connection->context->err) {
+        warning("Redis connection lost (%s), reconnecting...", connection->context->errstr);
+
+        if (!(redisPoolReconnect(self->pool, connection))) {
+            error("The command '%s' has not been replayed, the Redis server is unreachable.", argv[0]);
+        }
+        else if (redisCommandIsReplayable(argv[0])) {
+            reply = redisCommandArgv(connection->context, argc, argv, argvlen);
+        } else {
+            error("The command '%s' has not been replayed, it may have been executed already.", argv[0]);
+        }
+    }
+
+    redisPoolRelease(self->pool, connection);
+
+    return reply;
+}
+
+bool redisPipelineAppend(Redis *self, const char *format, ...) {
+
+    int status;
+    va_list args;
+
+    // The connection stays reserved until all the replies have been read
+    if (!self->pipeline && !(self->pipeline = redisPoolAcquire(self->pool))) {
+        error("Cannot get a Redis connection for the pipeline.");
+        return false;
+    }
+
+    va_start(args, format);
+        status = redisvAppendCommand(self->pipeline->context, format, args);
+    va_end(args);
+
+    if (status != REDIS_OK) {
+        error("Cannot append the command to the Redis pipeline.");
+        if (self->pipelineCount == 0) {
+            redisPoolRelease(self->pool, self->pipeline);
+            self->pipeline = NULL;
+        }
+        return false;
+    }
+
+    self->pipelineCount++;
+
+    return true;
+}
+
+redisReply *redisPipelineGetReply(Redis *self) {
+
+    redisReply *reply = NULL;
+    RedisConnection *connection = self->pipeline;
+
+    if (!connection || self->pipelineCount == 0) {
+        error("No pending reply in the Redis pipeline.");
+        return NULL;
+    }
+
+    if (redisGetReply(connection->context, (void **) &reply) != REDIS_OK) {
+        // The pipelined commands aren't replayed : we can't know which ones have been executed
+        error("Cannot get the reply of the Redis pipeline (%s).", connection->context->errstr);
+        redisPoolReconnect(self->pool, connection);
+        self->pipelineCount = 1;
+        reply = NULL;
+    }
+
+    if (--self->pipelineCount == 0) {
+        redisPoolRelease(self->pool, connection);
+        self->pipeline = NULL;
+    }
+
+    return reply;
 }
 
 void
@@ -250,11 +380,76 @@ void redisDestroy(Redis **_self) {
     if (_self && self) {
         redisInfoFree(&self->info);
 
-        if (self->context) {
-            redisFree (self->context);
+        if (self->pipeline) {
+            redisPoolRelease(self->pool, self->pipeline);
         }
 
+        redisPoolDestroy(&self->pool);
+
         free(self);
         *_self = NULL;
     }
 }
+
+// ------ Static function implementation -------
+
+static bool redisCommandIsReplayable(const char *command) {
+
+    for (int i = 0; redisNotReplayableCommands[i] != NULL; i++) {
+        size_t len = strlen(redisNotReplayableCommands[i]);
+        if (strncmp(command, redisNotReplayableCommands[i], len) == 0
+        && (command[len] == ' ' || command[len] == '\0')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static redisReply *redisCommandPooled(Redis *self, const char *format, ...) {
+
+    redisReply *reply = NULL;
+    va_list args;
+
+    va_start(args, format);
+        reply = redisvCommandPooled(self, format, args);
+    va_end(args);
+
+    return reply;
+}
+
+static redisReply *redisvCommandPooled(Redis *self, const char *format, va_list args) {
+
+    redisReply *reply = NULL;
+    RedisConnection *connection;
+    va_list argsCopy;
+
+    if (!(connection = redisPoolAcquire(self->pool))) {
+        return NULL;
+    }
+
+    va_copy(argsCopy, args);
+        reply = redisvCommand(connection->context, format, argsCopy);
+    va_end(argsCopy);
+
+    if (!reply && connection->context->err) {
+        warning("Redis connection lost (%s), reconnecting...", connection->context->errstr);
+
+        if (!(redisPoolReconnect(self->pool, connection))) {
+            error("The command '%.*s' has not been replayed, the Redis server is unreachable.",
+                (int) strcspn(format, " "), format);
+        }
+        else if (redisCommandIsReplayable(format)) {
+            va_copy(argsCopy, args);
+                reply = redisvCommand(connection->context, format, argsCopy);
+            va_end(argsCopy);
+        } else {
+            error("The command '%.*s' has not been replayed, it may have been executed already.",
+                (int) strcspn(format, " "), format);
+        }
+    }
+
+    redisPoolRelease(self->pool, connection);
+
+    return reply;
+}
@@ -42,6 +42,7 @@ typedef struct Redis Redis;
 typedef struct RedisInfo {
     char *hostname;
     int port;
+    int poolSize;
 } RedisInfo;
 
 /**
@@ -64,12 +65,13 @@ bool redisInit(Redis *self, RedisInfo *info);
  * @param self An allocated RedisInfo to initialize.
  * @param hostname The IP address of the Redis server
  * @param port The port of the Redis server
+ * @param poolSize The number of connections shared by the process
  * @return true on success, false otherwise.
  */
-bool redisInfoInit(RedisInfo *self, char *ip, int port);
+bool redisInfoInit(RedisInfo *self, char *ip, int port, int poolSize);
 
 /**
- * @brief : Connect to the Redis database
+ * @brief : Connect to the Redis database, through the connection pool of the process
  * @param self An allocated Redis instance
  * @return true on success, false otherwise
  */
@@ -84,6 +86,7 @@ bool redisFlushDatabase(Redis *self);
 
 /**
  * @brief Send a command to the redis server AND display it in the console.
+ *  If the connection is lost, the command is replayed after reconnection when it's safe to do so.
  * @param self An allocated Redis instance
  * @param format the format of the command
  * @param ... The values of the command
@@ -91,6 +94,43 @@ bool redisFlushDatabase(Redis *self);
  */
 redisReply *redisCommandDbg(Redis *self, char * format, ...);
 
+/**
+ * @brief Send a binary-safe command to the redis server.
+ *  Unlike redisCommandDbg, the format isn't expanded beforehand, so %b arguments can be used.
+ * @param self An allocated Redis instance
+ * @param format the format of the command
+ * @param ... The values of the command
+ * @return A redisReply
+ */
+redisReply *redisCommandBin(Redis *self, const char *format, ...);
+
+/**
+ * @brief Send a command built from an array of arguments to the redis server.
+ * @param self An allocated Redis instance
+ * @param argc The number of arguments
+ * @param argv The arguments, the first one being the command name
+ * @param argvlen The length of each argument. If NULL, the arguments are considered as strings.
+ * @return A redisReply
+ */
+redisReply *redisCommandArgvBin(Redis *self, int argc, const char **argv, const size_t *argvlen);
+
+/**
+ * @brief Queue a command in the output buffer without waiting for its reply.
+ *  Every appended command must be followed by a call to redisPipelineGetReply.
+ * @param self An allocated Redis instance
+ * @param format the format of the command
+ * @param ... The values of the command
+ * @return true on success, false otherwise
+ */
+bool redisPipelineAppend(Redis *self, const char *format, ...);
+
+/**
+ * @brief Get the reply of the oldest pipelined command.
+ * @param self An allocated Redis instance
+ * @return A redisReply
+ */
+redisReply *redisPipelineGetReply(Redis *self);
+
 /**
  * @brief Send data to the Redis Server.
  * @param self An allocated Redis instance
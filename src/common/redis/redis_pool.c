@@ -0,0 +1,270 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "redis_pool.h"
+
+
+// ------ Structure declaration -------
+/**
+ * @brief RedisPool is a set of connections to the same Redis server
+ */
+struct RedisPool
+{
+    /** Start up information about the Redis connections */
+    RedisInfo info;
+
+    /** Connections of the pool */
+    RedisConnection *connections;
+    size_t connectionsCount;
+
+    /** Protects the busy flags of the connections */
+    pthread_mutex_t mutex;
+
+    /** Signaled when a connection is released */
+    pthread_cond_t released;
+    bool lockReady;
+
+    /** Number of owners of the pool */
+    int refCount;
+};
+
+
+// ------ Static declaration -------
+/** The pool shared by all the threads of the process */
+static RedisPool *sharedPool = NULL;
+
+/**
+ * @brief Ping the connection if it has been idle for too long, and reconnect it if it's broken
+ * @param self An allocated RedisPool
+ * @param connection A connection acquired by the calling thread
+ * @return true if the connection can be used, false otherwise
+ */
+static bool redisPoolCheckConnection(RedisPool *self, RedisConnection *connection);
+
+
+// ------ Extern function implementation -------
+
+RedisPool *redisPoolNew(RedisInfo *info) {
+
+    RedisPool *self;
+
+    if ((self = calloc(1, sizeof(RedisPool))) == NULL) {
+        return NULL;
+    }
+
+    if (!redisPoolInit(self, info)) {
+        redisPoolDestroy(&self);
+        error("RedisPool failed to initialize.");
+        return NULL;
+    }
+
+    return self;
+}
+
+bool redisPoolInit(RedisPool *self, RedisInfo *info) {
+
+    redisInfoInit(&self->info, info->hostname, info->port, info->poolSize);
+
+    self->connectionsCount = (info->poolSize > 0) ? info->poolSize : REDIS_POOL_SIZE_DEFAULT;
+
+    if (!(self->connections = calloc(self->connectionsCount, sizeof(RedisConnection)))) {
+        error("Cannot allocate %d Redis connections.", self->connectionsCount);
+        return false;
+    }
+
+    if (pthread_mutex_init(&self->mutex, NULL) != 0) {
+        error("Cannot initialize the mutex.");
+        return false;
+    }
+
+    if (pthread_cond_init(&self->released, NULL) != 0) {
+        error("Cannot initialize the condition variable.");
+        pthread_mutex_destroy(&self->mutex);
+        return false;
+    }
+    self->lockReady = true;
+
+    self->refCount = 1;
+
+    return true;
+}
+
+RedisPool *redisPoolShared(RedisInfo *info) {
+
+    RedisPool *pool = sharedPool;
+
+    if (!pool) {
+        RedisPool *newPool;
+        if (!(newPool = redisPoolNew(info))) {
+            error("Cannot allocate the shared Redis pool.");
+            return NULL;
+        }
+
+        // Another thread may have created the pool in the meantime
+        if (__sync_bool_compare_and_swap(&sharedPool, NULL, newPool)) {
+            info("Redis pool of %d connections created.", newPool->connectionsCount);
+            return newPool;
+        }
+
+        redisPoolDestroy(&newPool);
+        pool = sharedPool;
+    }
+
+    __sync_fetch_and_add(&pool->refCount, 1);
+
+    return pool;
+}
+
+RedisConnection *redisPoolAcquire(RedisPool *self) {
+
+    RedisConnection *connection = NULL;
+
+    pthread_mutex_lock(&self->mutex);
+    while (!connection) {
+        for (size_t i = 0; i < self->connectionsCount; i++) {
+            if (!self->connections[i].busy) {
+                connection = &self->connections[i];
+                connection->busy = true;
+                break;
+            }
+        }
+
+        if (!connection) {
+            // All the connections are used, wait for one to be released
+            pthread_cond_wait(&self->released, &self->mutex);
+        }
+    }
+    pthread_mutex_unlock(&self->mutex);
+
+    if (!(redisPoolCheckConnection(self, connection))) {
+        error("Cannot get a working Redis connection.");
+        redisPoolRelease(self, connection);
+        return NULL;
+    }
+
+    return connection;
+}
+
+void redisPoolRelease(RedisPool *self, RedisConnection *connection) {
+
+    connection->lastUsed = zclock_mono();
+
+    pthread_mutex_lock(&self->mutex);
+    connection->busy = false;
+    pthread_cond_signal(&self->released);
+    pthread_mutex_unlock(&self->mutex);
+}
+
+bool redisPoolReconnect(RedisPool *self, RedisConnection *connection) {
+
+    RedisInfo *info = &self->info;
+    int delay = REDIS_POOL_RECONNECT_DELAY_MIN_MS;
+
+    for (int attempt = 1; ; attempt++) {
+        if (connection->context) {
+            redisFree(connection->context);
+        }
+
+        connection->context = redisConnectWithTimeout(info->hostname, info->port, (struct timeval) {.tv_sec = 3, .tv_usec = 0});
+
+        if (connection->context != NULL && !connection->context->err) {
+            // Connection OK
+            break;
+        }
+
+        if (attempt == REDIS_POOL_RECONNECT_ATTEMPTS_MAX) {
+            error("Redis server not detected (%s) after %d attempts.",
+                connection->context ? connection->context->errstr : "cannot allocate context", attempt);
+            if (connection->context) {
+                redisFree(connection->context);
+                connection->context = NULL;
+            }
+            return false;
+        }
+
+        warning("Redis server not detected (%s)... Retrying in %d ms.",
+            connection->context ? connection->context->errstr : "cannot allocate context", delay);
+        zclock_sleep(delay);
+
+        delay *= 2;
+        if (delay > REDIS_POOL_RECONNECT_DELAY_MAX_MS) {
+            delay = REDIS_POOL_RECONNECT_DELAY_MAX_MS;
+        }
+    }
+
+    connection->lastUsed = zclock_mono();
+
+    return true;
+}
+
+void redisPoolDestroy(RedisPool **_self) {
+
+    RedisPool *self = *_self;
+
+    if (_self && self) {
+        *_self = NULL;
+
+        if (__sync_sub_and_fetch(&self->refCount, 1) > 0) {
+            // Still used by another owner
+            return;
+        }
+
+        __sync_bool_compare_and_swap(&sharedPool, self, NULL);
+
+        for (size_t i = 0; i < self->connectionsCount; i++) {
+            if (self->connections[i].context) {
+                redisFree(self->connections[i].context);
+            }
+        }
+        free(self->connections);
+
+        if (self->lockReady) {
+            pthread_cond_destroy(&self->released);
+            pthread_mutex_destroy(&self->mutex);
+        }
+
+        redisInfoFree(&self->info);
+        free(self);
+    }
+}
+
+// ------ Static function implementation -------
+
+static bool redisPoolCheckConnection(RedisPool *self, RedisConnection *connection) {
+
+    redisContext *context = connection->context;
+
+    if (!context || context->err) {
+        // Never connected, or broken during its last use
+        return redisPoolReconnect(self, connection);
+    }
+
+    if (zclock_mono() - connection->lastUsed < REDIS_POOL_IDLE_PING_MS) {
+        return true;
+    }
+
+    // Idle connection : check it's still alive
+    redisReply *reply = redisCommand(context, "PING");
+    bool alive = (reply && reply->type == REDIS_REPLY_STATUS);
+    if (reply) {
+        freeReplyObject(reply);
+    }
+
+    if (!alive) {
+        warning("Idle Redis connection lost, reconnecting...");
+        return redisPoolReconnect(self, connection);
+    }
+
+    return true;
+}
@@ -0,0 +1,106 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file redis_pool.h
+ * @brief Process-wide pool of Redis connections.
+ *
+ * All the threads of a server process (Router, RouterMonitor, Workers, EventServer) share the same pool.
+ * A connection left idle is pinged before being handed out again, and a broken connection is
+ * reconnected with an exponential backoff, so a Redis restart or failover doesn't require to restart the servers.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+#include "R1EMU.h"
+#include "redis.h"
+
+/** Number of connections if not specified in the configuration */
+#define REDIS_POOL_SIZE_DEFAULT 4
+
+/** A connection idle for longer than this delay is pinged before being used */
+#define REDIS_POOL_IDLE_PING_MS 30000
+
+/** Reconnection backoff bounds */
+#define REDIS_POOL_RECONNECT_DELAY_MIN_MS 100
+#define REDIS_POOL_RECONNECT_DELAY_MAX_MS 3000
+
+/** Number of connection attempts before giving up and reporting the error to the caller */
+#define REDIS_POOL_RECONNECT_ATTEMPTS_MAX 5
+
+/**
+ * @brief RedisConnection is one connection of the pool
+ */
+typedef struct RedisConnection {
+    /** Redis context, handle of the connection to the redis server */
+    redisContext *context;
+
+    /** Last time the connection has been used (monotonic clock, in ms) */
+    int64_t lastUsed;
+
+    /** The connection is currently used by a thread */
+    bool busy;
+} RedisConnection;
+
+typedef struct RedisPool RedisPool;
+
+/**
+ * @brief Allocate a new RedisPool structure.
+ * @param info The information about the Redis database connections to etablish
+ * @return A pointer to an allocated RedisPool.
+ */
+RedisPool *redisPoolNew(RedisInfo *info);
+
+/**
+ * @brief Initialize an allocated RedisPool structure.
+ * @param self An allocated RedisPool to initialize.
+ * @param info The information about the Redis database connections to etablish
+ * @return true on success, false otherwise.
+ */
+bool redisPoolInit(RedisPool *self, RedisInfo *info);
+
+/**
+ * @brief Get the pool shared by all the threads of the process, and allocate it if needed.
+ *  Each call takes a reference on the pool, released with redisPoolDestroy.
+ * @param info The information about the Redis database connections to etablish
+ * @return A pointer to the shared RedisPool.
+ */
+RedisPool *redisPoolShared(RedisInfo *info);
+
+/**
+ * @brief Get a healthy connection from the pool, waiting for one to be available.
+ * @param self An allocated RedisPool
+ * @return A connection, reserved for the calling thread until redisPoolRelease.
+ *         NULL if the Redis server cannot be reached.
+ */
+RedisConnection *redisPoolAcquire(RedisPool *self);
+
+/**
+ * @brief Give back a connection to the pool.
+ * @param self An allocated RedisPool
+ * @param connection A connection previously acquired
+ */
+void redisPoolRelease(RedisPool *self, RedisConnection *connection);
+
+/**
+ * @brief (Re)connect a connection of the pool.
+ *        Retries with an exponential backoff, up to REDIS_POOL_RECONNECT_ATTEMPTS_MAX attempts.
+ * @param self An allocated RedisPool
+ * @param connection A connection acquired by the calling thread
+ * @return true on success, false otherwise
+ */
+bool redisPoolReconnect(RedisPool *self, RedisConnection *connection);
+
+/**
+ * @brief Release a reference on a RedisPool, free it when it isn't referenced anymore, and nullify the pointer.
+ * @param self A pointer to an allocated RedisPool.
+ */
+void redisPoolDestroy(RedisPool **self);
@@ -0,0 +1,170 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "redis_scripts.h"
+#include "fields/redis_socket_session.h"
+
+
+// ------ Structure declaration -------
+
+
+// ------ Static declaration -------
+/** Sources of the scripts */
+static const char *redisScriptsSrc[REDIS_SCRIPT_COUNT] = {
+
+    // KEYS : [1] session, [2] source map members, [3] destination map members
+    // ARGV : [1] accountId
+    [REDIS_SCRIPT_MOVE_SESSION] =
+        "if redis.call('EXISTS', KEYS[1]) == 0 then\n"
+        "    return redis.error_reply('no such game session')\n"
+        "end\n"
+        "if redis.call('SMOVE', KEYS[2], KEYS[3], ARGV[1]) == 0 then\n"
+        "    redis.call('SADD', KEYS[3], ARGV[1])\n"
+        "end\n"
+        "return 1\n",
+
+    // KEYS : [1] socket session, [2] map members, [3] game session, [4] game session blob
+    // ARGV : [1] routerId, [2] mapId, [3] accountId of the socket session read by the caller,
+    //        [4..n] game session fields to return
+    // Return : {blob, fields}
+    // The game session is only flushed if it still belongs to the map of the socket session :
+    // otherwise it has been moved to another server, that owns it now.
+    [REDIS_SCRIPT_FLUSH_SESSION] =
+        "local socket = redis.call('HMGET', KEYS[1],"
+            " '" REDIS_SOCKET_SESSION_routerId_str "',"
+            " '" REDIS_SOCKET_SESSION_mapId_str "',"
+            " '" REDIS_SOCKET_SESSION_accountId_str "')\n"
+        "if not socket[1] then\n"
+        "    return {false, false}\n"
+        "end\n"
+        "if socket[1] ~= ARGV[1] or socket[2] ~= ARGV[2] or socket[3] ~= ARGV[3] then\n"
+        "    return redis.error_reply('the socket session has changed')\n"
+        "end\n"
+        "if redis.call('SREM', KEYS[2], ARGV[3]) == 0 then\n"
+        "    redis.call('DEL', KEYS[1])\n"
+        "    return {false, false}\n"
+        "end\n"
+        "local fields = false\n"
+        "if #ARGV > 3 then\n"
+        "    fields = redis.call('HMGET', KEYS[3], unpack(ARGV, 4))\n"
+        "end\n"
+        "local blob = redis.call('GET', KEYS[4])\n"
+        "redis.call('DEL', KEYS[3], KEYS[4], KEYS[1])\n"
+        "return {blob, fields}\n",
+
+    // KEYS : [1] socket session, [2] game session, [3] game session blob
+    // ARGV : [1] accountId of the socket session read by the caller, [2..n] game session fields to return
+    // Return : {blob, fields}
+    [REDIS_SCRIPT_GET_SESSION_BY_SOCKET] =
+        "if redis.call('HGET', KEYS[1], '" REDIS_SOCKET_SESSION_accountId_str "') ~= ARGV[1] then\n"
+        "    return redis.error_reply('the socket session has changed')\n"
+        "end\n"
+        "if redis.call('EXISTS', KEYS[2]) == 0 then\n"
+        "    return {false, false}\n"
+        "end\n"
+        "local fields = false\n"
+        "if #ARGV > 1 then\n"
+        "    fields = redis.call('HMGET', KEYS[2], unpack(ARGV, 2))\n"
+        "end\n"
+        "local blob = redis.call('GET', KEYS[3])\n"
+        "return {blob, fields}\n",
+};
+
+/** SHA1 digests of the scripts, shared by the whole process */
+static char redisScriptsSha[REDIS_SCRIPT_COUNT][REDIS_SCRIPT_SHA_SIZE + 1];
+
+/** 0 = not loaded, 1 = loading, 2 = loaded */
+static volatile int redisScriptsState = 0;
+
+
+// ------ Extern function implementation -------
+
+bool redisScriptsLoad(Redis *self) {
+
+    if (!(__sync_bool_compare_and_swap(&redisScriptsState, 0, 1))) {
+        // Another thread loads the scripts
+        while (redisScriptsState != 2) {
+            zclock_sleep(1);
+        }
+        return true;
+    }
+
+    for (int scriptId = 0; scriptId < REDIS_SCRIPT_COUNT; scriptId++) {
+        redisReply *reply = redisCommandBin(self, "SCRIPT LOAD %s", redisScriptsSrc[scriptId]);
+
+        if (!reply) {
+            error("Redis error encountered : The request is invalid.");
+            redisScriptsState = 0;
+            return false;
+        }
+
+        switch (reply->type)
+        {
+            case REDIS_REPLY_ERROR:
+                error("Cannot load the script %d : %s", scriptId, reply->str);
+                redisReplyDestroy(&reply);
+                redisScriptsState = 0;
+                return false;
+                break;
+
+            case REDIS_REPLY_STRING:
+                strncpy(redisScriptsSha[scriptId], reply->str, REDIS_SCRIPT_SHA_SIZE);
+                break;
+
+            default :
+                error("Unexpected Redis status (%d).", reply->type);
+                redisReplyDestroy(&reply);
+                redisScriptsState = 0;
+                return false;
+                break;
+        }
+
+        redisReplyDestroy(&reply);
+    }
+
+    redisScriptsState = 2;
+
+    return true;
+}
+
+redisReply *redisScriptCall(Redis *self, RedisScriptId scriptId, int keysCount, int argc, const char **argv) {
+
+    redisReply *reply = NULL;
+    const char *args[REDIS_SCRIPT_ARGS_MAX + 3];
+    char keysCountStr[16];
+
+    if (argc > REDIS_SCRIPT_ARGS_MAX) {
+        error("Too many arguments for the script %d (%d).", scriptId, argc);
+        return NULL;
+    }
+
+    snprintf(keysCountStr, sizeof(keysCountStr), "%d", keysCount);
+
+    args[0] = "EVALSHA";
+    args[1] = redisScriptsSha[scriptId];
+    args[2] = keysCountStr;
+    memcpy(&args[3], argv, sizeof(*argv) * argc);
+
+    reply = redisCommandArgvBin(self, argc + 3, args, NULL);
+
+    if (reply && reply->type == REDIS_REPLY_ERROR && strncmp(reply->str, "NOSCRIPT", strlen("NOSCRIPT")) == 0) {
+        // The scripts cache has been flushed : send the source again, it caches the script as well
+        redisReplyDestroy(&reply);
+        args[0] = "EVAL";
+        args[1] = redisScriptsSrc[scriptId];
+        reply = redisCommandArgvBin(self, argc + 3, args, NULL);
+    }
+
+    return reply;
+}
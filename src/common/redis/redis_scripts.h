@@ -0,0 +1,58 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file redis_scripts.h
+ * @brief Server-side Lua scripts, executed atomically by Redis in one round trip.
+ *
+ * The scripts are loaded with SCRIPT LOAD when connecting, and called with EVALSHA.
+ * If the server lost its scripts cache (restart, failover), the script is sent again with EVAL.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+#include "R1EMU.h"
+#include "redis.h"
+
+/** Size of a script SHA1 digest, in hexadecimal */
+#define REDIS_SCRIPT_SHA_SIZE 40
+
+/** Maximum number of keys + arguments of a script call */
+#define REDIS_SCRIPT_ARGS_MAX 128
+
+typedef enum RedisScriptId {
+    /** Move a game session to another map */
+    REDIS_SCRIPT_MOVE_SESSION,
+    /** Return a game session, and flush it with its socket session and its map membership */
+    REDIS_SCRIPT_FLUSH_SESSION,
+    /** Return the game session of a socket session */
+    REDIS_SCRIPT_GET_SESSION_BY_SOCKET,
+
+    REDIS_SCRIPT_COUNT
+} RedisScriptId;
+
+/**
+ * @brief Load all the scripts in the Redis scripts cache
+ * @param self An allocated and connected Redis instance
+ * @return true on success, false otherwise
+ */
+bool redisScriptsLoad(Redis *self);
+
+/**
+ * @brief Call a script with EVALSHA
+ * @param self An allocated Redis instance
+ * @param scriptId The script to call
+ * @param keysCount The number of keys at the beginning of argv
+ * @param argc The number of keys + arguments
+ * @param argv The keys followed by the arguments of the script
+ * @return A redisReply
+ */
+redisReply *redisScriptCall(Redis *self, RedisScriptId scriptId, int keysCount, int argc, const char **argv);
@@ -0,0 +1,171 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "broadcast_packet.h"
+#include "router.h"
+#include "common/packet/packet.h"
+
+// ------ Structure declaration -------
+/**
+ * @brief BroadcastPacket contains a packet shared by the EventServer, ZMQ and the Router
+ */
+struct BroadcastPacket
+{
+    // references to the packet, the last one frees it
+    size_t references;
+
+    // identities of the recipients
+    uint8_t (*recipients)[SOCKET_SESSION_IDENTITY_SIZE];
+    size_t recipientsCount;
+    size_t recipientsCapacity;
+
+    // the encoded packet, never modified once built
+    size_t packetSize;
+    uint8_t packet[];
+};
+
+// ------ Static declaration -------
+/**
+ * @brief Drop the reference held by ZMQ, once the packet has been sent
+ */
+static void broadcastPacketRelease(void *packet, void *self);
+
+
+// ------ Extern function implementation -------
+
+BroadcastPacket *broadcastPacketNew(const void *packet, size_t packetSize) {
+    BroadcastPacket *self;
+
+    if ((self = malloc(sizeof(BroadcastPacket) + packetSize)) == NULL) {
+        return NULL;
+    }
+
+    self->references = 1;
+    self->recipientsCount = 0;
+    self->recipientsCapacity = BROADCAST_PACKET_RECIPIENTS_DEFAULT_COUNT;
+    self->packetSize = packetSize;
+    memcpy(self->packet, packet, packetSize);
+
+    if (!(self->recipients = malloc(sizeof(*self->recipients) * self->recipientsCapacity))) {
+        broadcastPacketDestroy(&self);
+        error("Cannot allocate the recipients of the packet.");
+        return NULL;
+    }
+
+    return self;
+}
+
+bool broadcastPacketAddRecipient(BroadcastPacket *self, const uint8_t identity[SOCKET_SESSION_IDENTITY_SIZE]) {
+
+    if (self->recipientsCount == self->recipientsCapacity) {
+        size_t capacity = self->recipientsCapacity * 2;
+        void *recipients;
+
+        if (!(recipients = realloc(self->recipients, sizeof(*self->recipients) * capacity))) {
+            error("Cannot grow the recipients of the packet to %d.", capacity);
+            return false;
+        }
+
+        self->recipients = recipients;
+        self->recipientsCapacity = capacity;
+    }
+
+    memcpy(self->recipients[self->recipientsCount++], identity, SOCKET_SESSION_IDENTITY_SIZE);
+    return true;
+}
+
+size_t broadcastPacketGetRecipientsCount(BroadcastPacket *self) {
+    return self->recipientsCount;
+}
+
+bool broadcastPacketSend(BroadcastPacket *self, zsock_t *router) {
+
+    bool status = false;
+    bool partial = false;
+    void *socket = zsock_resolve(router);
+    zmq_msg_t packet;
+
+    if (self->recipientsCount == 0) {
+        // Nobody to send it to
+        return true;
+    }
+
+    // Build the data frame before sending anything, so a failure leaves the socket untouched
+    // ZMQ holds a reference to the packet instead of copying it
+    BroadcastPacket *reference = broadcastPacketRef(self);
+    if (zmq_msg_init_data(&packet, self->packet, self->packetSize, broadcastPacketRelease, reference) != 0) {
+        broadcastPacketDestroy(&reference);
+        error("Cannot initialize the multicast packet.");
+        return false;
+    }
+
+    // [1 frame header] + [1 frame data] + [1 frame identity] + [1 frame identity] + ...
+    if (zmq_send(socket, PACKET_HEADER(ROUTER_WORKER_MULTICAST), sizeof(ROUTER_WORKER_MULTICAST), ZMQ_SNDMORE) == -1) {
+        zmq_msg_close(&packet);
+        error("Cannot send the multicast header to the Router.");
+        goto cleanup;
+    }
+    partial = true;
+
+    if (zmq_msg_send(&packet, socket, ZMQ_SNDMORE) == -1) {
+        zmq_msg_close(&packet);
+        error("Cannot send the multicast packet to the Router.");
+        goto cleanup;
+    }
+
+    for (size_t i = 0; i < self->recipientsCount; i++) {
+        int flags = (i + 1 < self->recipientsCount) ? ZMQ_SNDMORE : 0;
+        if (zmq_send(socket, self->recipients[i], SOCKET_SESSION_IDENTITY_SIZE, flags) == -1) {
+            error("Cannot send the multicast identities to the Router.");
+            goto cleanup;
+        }
+    }
+    partial = false;
+
+    status = true;
+
+cleanup:
+    if (partial) {
+        // The next message would be glued to the frames already sent :
+        // close the message with an empty frame, that the Router drops
+        if (zmq_send(socket, "", 0, 0) == -1) {
+            error("Cannot close the partial multicast message.");
+        }
+    }
+
+    return status;
+}
+
+BroadcastPacket *broadcastPacketRef(BroadcastPacket *self) {
+    __atomic_add_fetch(&self->references, 1, __ATOMIC_RELAXED);
+    return self;
+}
+
+void broadcastPacketDestroy(BroadcastPacket **_self) {
+    BroadcastPacket *self = *_self;
+
+    // ZMQ may drop its reference from another thread
+    if (self && __atomic_sub_fetch(&self->references, 1, __ATOMIC_ACQ_REL) == 0) {
+        free(self->recipients);
+        free(self);
+    }
+
+    *_self = NULL;
+}
+
+// ------ Static function implementation -------
+
+static void broadcastPacketRelease(void *packet, void *self) {
+    broadcastPacketDestroy((BroadcastPacket **) &self);
+}
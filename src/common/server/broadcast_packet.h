@@ -0,0 +1,77 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file broadcast_packet.h
+ * @brief BroadcastPacket is a packet encoded once for a list of recipients.
+ *
+ * The packet is copied once in an immutable buffer counting its references, next to the identities of its recipients.
+ * It is handed to ZMQ without copy when sent to the Router, and the Router shares it between all the recipients.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+// ---------- Includes ------------
+#include "R1EMU.h"
+#include "common/session/socket_session.h"
+
+// ---------- Defines -------------
+/** Number of recipients allocated with a new BroadcastPacket, it grows with the recipients added */
+#define BROADCAST_PACKET_RECIPIENTS_DEFAULT_COUNT 32
+
+// ------ Structure declaration -------
+typedef struct BroadcastPacket BroadcastPacket;
+
+// ----------- Functions ------------
+/**
+ * @brief Allocate a new BroadcastPacket structure, with one reference.
+ * @param packet The encoded packet, copied in the BroadcastPacket
+ * @param packetSize The size of the packet
+ * @return A pointer to an allocated BroadcastPacket, or NULL if an error occured.
+ */
+BroadcastPacket *broadcastPacketNew(const void *packet, size_t packetSize);
+
+/**
+ * @brief Add a recipient to the packet.
+ * @param self An allocated BroadcastPacket
+ * @param identity The identity of the client in the Router
+ * @return true on success, false otherwise
+ */
+bool broadcastPacketAddRecipient(BroadcastPacket *self, const uint8_t identity[SOCKET_SESSION_IDENTITY_SIZE]);
+
+/**
+ * @brief Get the number of recipients of the packet
+ * @param self An allocated BroadcastPacket
+ * @return the number of recipients
+ */
+size_t broadcastPacketGetRecipientsCount(BroadcastPacket *self);
+
+/**
+ * @brief Send the packet and its recipients to the Router, as a ROUTER_WORKER_MULTICAST message.
+ *        ZMQ keeps a reference to the packet until it has been sent.
+ * @param self An allocated BroadcastPacket
+ * @param router The socket connected to the Router
+ * @return true on success, false otherwise
+ */
+bool broadcastPacketSend(BroadcastPacket *self, zsock_t *router);
+
+/**
+ * @brief Add a reference to a BroadcastPacket.
+ * @param self An allocated BroadcastPacket
+ * @return the BroadcastPacket
+ */
+BroadcastPacket *broadcastPacketRef(BroadcastPacket *self);
+
+/**
+ * @brief Drop a reference to a BroadcastPacket, free it with the last one, and nullify the content of the pointer.
+ * @param self A pointer to an allocated BroadcastPacket.
+ */
+void broadcastPacketDestroy(BroadcastPacket **self);
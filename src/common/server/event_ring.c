@@ -0,0 +1,205 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "event_ring.h"
+
+#ifdef EVENT_RING_ENABLED
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+// ---------- Defines -------------
+#define EVENT_RING_CACHE_LINE_SIZE 64
+
+// ------ Structure declaration -------
+/**
+ * @brief EventRing is a bounded multi-producers single-consumer queue of GameEvents
+ */
+struct EventRing
+{
+    // slots of the ring, and the mask giving the slot of a position
+    EventRingSlot *slots;
+    size_t capacity;
+    size_t mask;
+
+    // next position reserved by the producers, alone in its cache line
+    size_t head;
+    uint8_t headPadding[EVENT_RING_CACHE_LINE_SIZE - sizeof(size_t)];
+
+    // next position read by the consumer, alone in its cache line
+    size_t tail;
+    uint8_t tailPadding[EVENT_RING_CACHE_LINE_SIZE - sizeof(size_t)];
+
+    // eventfd waking up the consumer, and true while a wake up is pending
+    int wakeUpFd;
+    int wakeUpPending;
+};
+
+
+// ------ Extern function implementation -------
+
+EventRing *eventRingNew(size_t capacity) {
+    EventRing *self;
+
+    if ((self = calloc(1, sizeof(EventRing))) == NULL) {
+        return NULL;
+    }
+
+    if (!eventRingInit(self, capacity)) {
+        eventRingDestroy(&self);
+        error("EventRing failed to initialize.");
+        return NULL;
+    }
+
+    return self;
+}
+
+bool eventRingInit(EventRing *self, size_t capacity) {
+
+    self->wakeUpFd = -1;
+    self->slots = NULL;
+
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        error("The capacity of the ring must be a power of 2 : %d.", capacity);
+        return false;
+    }
+
+    if (!(self->slots = malloc(sizeof(EventRingSlot) * capacity))) {
+        error("Cannot allocate the slots of the ring.");
+        return false;
+    }
+
+    for (size_t position = 0; position < capacity; position++) {
+        self->slots[position].sequence = position;
+    }
+
+    self->capacity = capacity;
+    self->mask = capacity - 1;
+    self->head = 0;
+    self->tail = 0;
+    self->wakeUpPending = false;
+
+    if ((self->wakeUpFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1) {
+        error("Cannot create the eventfd of the ring.");
+        return false;
+    }
+
+    return true;
+}
+
+EventRingSlot *eventRingReserve(EventRing *self) {
+
+    for (int retry = 0; retry < EVENT_RING_PUSH_RETRIES; retry++) {
+
+        size_t position = __atomic_load_n(&self->head, __ATOMIC_RELAXED);
+
+        for (;;) {
+            EventRingSlot *slot = &self->slots[position & self->mask];
+            size_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+            intptr_t diff = (intptr_t) sequence - (intptr_t) position;
+
+            if (diff == 0) {
+                // The slot is free : try to take it before the other producers
+                if (__atomic_compare_exchange_n(&self->head, &position, position + 1,
+                    true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                    return slot;
+                }
+                // position has been reloaded by the failed exchange
+            }
+            else if (diff < 0) {
+                // The consumer didn't release this slot yet : the ring is full
+                break;
+            }
+            else {
+                // Another producer took the slot
+                position = __atomic_load_n(&self->head, __ATOMIC_RELAXED);
+            }
+        }
+
+        zclock_sleep(1);
+    }
+
+    return NULL;
+}
+
+void eventRingPublish(EventRing *self, EventRingSlot *slot, size_t eventSize) {
+
+    size_t position = slot->sequence;
+    uint64_t wakeUp = 1;
+
+    slot->eventSize = eventSize;
+    __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+
+    // Only the first producer since the last wake up signals the consumer
+    if (!__atomic_exchange_n(&self->wakeUpPending, true, __ATOMIC_SEQ_CST)) {
+        if (write(self->wakeUpFd, &wakeUp, sizeof(wakeUp)) != sizeof(wakeUp)) {
+            error("Cannot wake up the consumer of the ring.");
+        }
+    }
+}
+
+EventRingSlot *eventRingPeek(EventRing *self) {
+
+    EventRingSlot *slot = &self->slots[self->tail & self->mask];
+
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != self->tail + 1) {
+        // The next event isn't published yet
+        return NULL;
+    }
+
+    return slot;
+}
+
+void eventRingRelease(EventRing *self, EventRingSlot *slot) {
+
+    // The slot becomes free for the position a lap later
+    __atomic_store_n(&slot->sequence, self->tail + self->capacity, __ATOMIC_RELEASE);
+    self->tail++;
+}
+
+int eventRingGetFd(EventRing *self) {
+    return self->wakeUpFd;
+}
+
+void eventRingClearWakeUp(EventRing *self) {
+
+    uint64_t wakeUps;
+
+    // Clear the pending flag before reading the ring, so an event published afterward signals again
+    if (read(self->wakeUpFd, &wakeUps, sizeof(wakeUps)) == -1 && errno != EAGAIN) {
+        error("Cannot read the eventfd of the ring.");
+    }
+    __atomic_store_n(&self->wakeUpPending, false, __ATOMIC_SEQ_CST);
+}
+
+void eventRingFree(EventRing *self) {
+    if (self->wakeUpFd != -1) {
+        close(self->wakeUpFd);
+    }
+    free(self->slots);
+}
+
+void eventRingDestroy(EventRing **_self) {
+    EventRing *self = *_self;
+
+    if (self) {
+        eventRingFree(self);
+        free(self);
+    }
+
+    *_self = NULL;
+}
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file event_ring.h
+ * @brief Lock-free ring of GameEvents, from the Workers to an EventServer of the same process.
+ *
+ * Any number of Workers write their events in place into the preallocated slots of the ring,
+ * and the single EventServer reading it is woken up through an eventfd registered in its reactor.
+ * The producers reserve a slot with a compare-and-swap on the head, and each slot has a sequence number
+ * telling whether it is free, or ready to be read.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+// ---------- Includes ------------
+#include "R1EMU.h"
+#include "common/server/game_event.h"
+
+// ---------- Defines -------------
+/** Number of slots of a ring, it must be a power of 2 */
+#define EVENT_RING_CAPACITY 2048
+
+/** Number of attempts of a producer to find a free slot in a full ring, every millisecond */
+#define EVENT_RING_PUSH_RETRIES 100
+
+/** The rings need an eventfd to wake up the EventServer : elsewhere the events go through ZMQ */
+#ifdef __linux__
+#define EVENT_RING_ENABLED
+#endif
+
+// ------ Structure declaration -------
+/**
+ * @brief EventRingSlot contains one event written in place by a producer
+ */
+typedef struct EventRingSlot {
+    // position of the slot in the ring when it is free, and the position + 1 when the event is ready
+    size_t sequence;
+    // size of the GameEvent, without the unused part of its data
+    size_t eventSize;
+    GameEvent event;
+} EventRingSlot;
+
+typedef struct EventRing EventRing;
+
+// ----------- Functions ------------
+/**
+ * @brief Allocate a new EventRing structure.
+ * @param capacity The number of slots, a power of 2
+ * @return A pointer to an allocated EventRing, or NULL if an error occured.
+ */
+EventRing *eventRingNew(size_t capacity);
+
+/**
+ * @brief Initialize an allocated EventRing structure.
+ * @param self An allocated EventRing to initialize.
+ * @param capacity The number of slots, a power of 2
+ * @return true on success, false otherwise.
+ */
+bool eventRingInit(EventRing *self, size_t capacity);
+
+/**
+ * @brief Reserve a free slot of the ring, the event has to be written in place and published afterward.
+ *        It can be called by several threads at the same time.
+ * @param self An allocated EventRing
+ * @return the reserved slot, or NULL if the ring stayed full
+ */
+EventRingSlot *eventRingReserve(EventRing *self);
+
+/**
+ * @brief Make an event written in a reserved slot visible to the consumer, and wake it up if needed.
+ * @param self An allocated EventRing
+ * @param slot The slot reserved with eventRingReserve
+ * @param eventSize The size of the GameEvent written in the slot
+ */
+void eventRingPublish(EventRing *self, EventRingSlot *slot, size_t eventSize);
+
+/**
+ * @brief Get the oldest event published in the ring. Only the consumer can call it.
+ * @param self An allocated EventRing
+ * @return the slot of the event, or NULL if the ring is empty
+ */
+EventRingSlot *eventRingPeek(EventRing *self);
+
+/**
+ * @brief Give back to the producers the slot returned by eventRingPeek, once its event has been processed.
+ * @param self An allocated EventRing
+ * @param slot The slot returned by eventRingPeek
+ */
+void eventRingRelease(EventRing *self, EventRingSlot *slot);
+
+/**
+ * @brief Get the file descriptor signaled when events are published, to register in a reactor.
+ * @param self An allocated EventRing
+ * @return the eventfd of the ring
+ */
+int eventRingGetFd(EventRing *self);
+
+/**
+ * @brief Acknowledge the wake up of the consumer, before it reads the ring.
+ * @param self An allocated EventRing
+ */
+void eventRingClearWakeUp(EventRing *self);
+
+/**
+ * @brief Free an allocated EventRing structure.
+ * @param self A pointer to an allocated EventRing.
+ */
+void eventRingFree(EventRing *self);
+
+/**
+ * @brief Free an allocated EventRing structure and nullify the content of the pointer.
+ * @param self A pointer to an allocated EventRing.
+ */
+void eventRingDestroy(EventRing **self);
@@ -18,6 +18,9 @@
 #include "common/packet/packet.h"
 #include "common/redis/fields/redis_game_session.h"
 #include "common/redis/fields/redis_session.h"
+#include "common/server/map_grid.h"
+#include "common/server/event_ring.h"
+#include "common/server/broadcast_packet.h"
 #include "barrack_server/barrack_event_server.h"
 #include "zone_server/zone_event_server.h"
 
@@ -29,6 +32,9 @@ struct EventServer
     // socket connected to the workers
     zsock_t *eventsInput;
 
+    // ring of the events written in place by the workers of this process, or NULL
+    EventRing *eventsRing;
+
     // frontend connected to the router
     zsock_t *router;
 
@@ -38,6 +44,32 @@ struct EventServer
     // graph of interconnected clients
     Graph *clientsGraph;
 
+    // spatial grids of the clients, by mapId
+    zhash_t *mapGrids;
+
+    // client nodes, by compact ID
+    GraphNode **clientsById;
+    size_t clientsByIdCapacity;
+
+    // released compact IDs, and next compact ID never used
+    NeighborSet freeClientIds;
+    ClientId_t nextClientId;
+
+    // buffers of the visible sets diff
+    NeighborSet aroundIds, enteredIds, leftIds;
+
+    // buffer of the recipients of a packet
+    NeighborSet fanOutIds;
+
+    // clients with a queued update, and clients with updates to receive, during the current tick
+    NeighborSet tickMovers, tickObservers;
+
+    // buffer of the receivers of an update
+    NeighborSet tickReceivers;
+
+    // ticks counter
+    uint32_t tick;
+
     // EventServer information
     EventServerInfo info;
 
@@ -45,7 +77,66 @@ struct EventServer
     bool (*eventServerProcess)(EventServer *self, EventType type, void *eventData);
 };
 
-static int eventServerSubscribe(EventServer *self);
+static int eventServerSubscribe(zloop_t *loop, zsock_t *eventsInput, void *_self);
+
+#ifdef EVENT_RING_ENABLED
+/**
+ * @brief Process the events written in the ring of the EventServer, when its eventfd is signaled
+ * @return 0 on success, -1 to stop the reactor
+ */
+static int eventServerReadRing(zloop_t *loop, zmq_pollitem_t *item, void *_self);
+
+/**
+ * Rings of the EventServers running in this process, by shard.
+ * They are registered before the Workers start, and the events of the other processes go through ZMQ.
+ */
+static EventRing *eventServerRings[EVENT_SERVER_SHARDS_MAX];
+#endif
+
+/** Number of EventServer shards of the process, set once before the servers start */
+static uint16_t eventServerShardsCount = 1;
+
+/**
+ * @brief Send the updates queued during the tick to the clients around
+ */
+static int eventServerTick(zloop_t *loop, int timerId, void *_self);
+
+/**
+ * @brief Get the LOD band of an observer of a client, according to their distance
+ */
+static EventServerLodBand eventServerGetLodBand(EventServer *self, GraphNodeClient *client, GraphNodeClient *observer);
+
+/**
+ * @brief Append a queued update to the tick batch of a client
+ * @return true on success, false otherwise
+ */
+static bool eventServerAppendTickBatch(EventServer *self, GraphNodeClient *observer, uint8_t *update, size_t updateSize);
+
+/**
+ * @brief Get the spatial grid of a map
+ * @param self An allocated EventServer
+ * @param mapId The mapId of the grid
+ * @param cellSize The cell size of the grid, if it needs to be created
+ * @return the grid of the map, or NULL if it cannot be created
+ */
+static MapGrid *eventServerGetMapGrid(EventServer *self, MapId_t mapId, float cellSize);
+
+/**
+ * @brief Give a compact ID to a client node
+ * @return true on success, false otherwise
+ */
+static bool eventServerAcquireClientId(EventServer *self, GraphNode *node);
+
+/**
+ * @brief Release the compact ID of a client node
+ */
+static void eventServerReleaseClientId(EventServer *self, GraphNode *node);
+
+/**
+ * @brief Send a packet to the clients, with the identities cached in their nodes
+ * @return true on success, false otherwise
+ */
+static bool eventServerMulticast(EventServer *self, ClientId_t *clients, size_t clientsCount, uint8_t *packet, size_t packetLen);
 
 EventServer *eventServerNew(EventServerInfo *info, ServerType serverType) {
     EventServer *self;
@@ -78,6 +169,16 @@ bool eventServerInit(EventServer *self, EventServerInfo *info, ServerType server
         return false;
     }
 
+    // create the ring of the events dispatched from this process
+    self->eventsRing = NULL;
+    #ifdef EVENT_RING_ENABLED
+    if (!(self->eventsRing = eventRingNew(EVENT_RING_CAPACITY))) {
+        error("Cannot allocate a new events ring.");
+        return false;
+    }
+    eventServerRings[info->shardId] = self->eventsRing;
+    #endif
+
     // initialize Redis connection
     if (!(self->redis = redisNew(&info->redisInfo))) {
         error("Cannot initialize a new Redis connection.");
@@ -90,6 +191,21 @@ bool eventServerInit(EventServer *self, EventServerInfo *info, ServerType server
         return false;
     }
 
+    // initialize the spatial grids of the maps
+    if (!(self->mapGrids = zhash_new())) {
+        error("Cannot allocate a new hashtable of map grids.");
+        return false;
+    }
+
+    neighborSetInit(&self->freeClientIds);
+    neighborSetInit(&self->aroundIds);
+    neighborSetInit(&self->enteredIds);
+    neighborSetInit(&self->leftIds);
+    neighborSetInit(&self->fanOutIds);
+    neighborSetInit(&self->tickMovers);
+    neighborSetInit(&self->tickObservers);
+    neighborSetInit(&self->tickReceivers);
+
     switch (serverType)
     {
         case SERVER_TYPE_BARRACK:
@@ -144,21 +260,40 @@ bool eventServerFlushSession(EventServer *self, uint8_t *sessionKey) {
 
 bool graphNodeClientInit (GraphNodeClient *self) {
 
+    self->id = CLIENT_ID_NONE;
+    neighborSetInit(&self->neighbors);
+    self->grid = NULL;
+    self->tickUpdateSize = 0;
+    self->tickSlotsCount = 0;
+    neighborSetInit(&self->tickReceivers);
+    self->tickBatch = NULL;
+    self->tickBatchSize = 0;
+    self->tickBatchCapacity = 0;
+    self->appearance = NULL;
+    self->appearanceSize = 0;
+
     return true;
 }
 
 bool eventServerInfoInit (EventServerInfo *self,
     RouterId_t routerId,
+    uint16_t shardId,
     uint16_t workersCount,
     char *redisHostname,
-    int redisPort
+    int redisPort,
+    int redisPoolSize,
+    float lodNearRange,
+    float lodMidRange
 ) {
     memset(self, 0, sizeof(EventServerInfo));
 
     self->routerId = routerId;
+    self->shardId = shardId;
     self->workersCount = workersCount;
+    self->lodNearRange = lodNearRange;
+    self->lodMidRange = lodMidRange;
 
-    if (!(redisInfoInit(&self->redisInfo, redisHostname, redisPort))) {
+    if (!(redisInfoInit(&self->redisInfo, redisHostname, redisPort, redisPoolSize))) {
         error("Cannot initialize Redis startup.");
         return false;
     }
@@ -209,19 +344,106 @@ eventServerGetGameSessionBySocketId (
     return redisGetGameSessionBySocketId (self->redis, routerId, socketId, gameSession);
 }
 
+bool
+eventServerSetClientAppearance (
+    EventServer *self,
+    uint8_t *sessionKey,
+    void *appearance,
+    size_t appearanceSize
+) {
+    GraphNode *node;
+    GraphNodeClient *client;
+
+    if (!(node = eventServerGetClientNode(self, sessionKey))) {
+        error("Cannot get the node %s.", sessionKey);
+        return false;
+    }
+    client = node->user_data;
+
+    if (client->appearanceSize != appearanceSize) {
+        void *newAppearance;
+        if (!(newAppearance = realloc(client->appearance, appearanceSize))) {
+            error("Cannot allocate the appearance of %s.", sessionKey);
+            return false;
+        }
+        client->appearance = newAppearance;
+        client->appearanceSize = appearanceSize;
+    }
+
+    memcpy(client->appearance, appearance, appearanceSize);
+
+    return true;
+}
+
+void *
+eventServerGetClientAppearance (
+    EventServer *self,
+    uint8_t *sessionKey,
+    size_t *appearanceSize
+) {
+    GraphNode *node;
+    GraphNodeClient *client;
+
+    // Don't create the node of an unknown client
+    if (!(node = graphGetNode(self->clientsGraph, (char *) sessionKey))) {
+        return NULL;
+    }
+    client = node->user_data;
+
+    *appearanceSize = client->appearanceSize;
+    return client->appearance;
+}
+
+#ifdef EVENT_RING_ENABLED
+static int
+eventServerReadRing (
+    zloop_t *loop,
+    zmq_pollitem_t *item,
+    void *_self
+) {
+    EventServer *self = (EventServer *) _self;
+    EventRingSlot *slot;
+
+    eventRingClearWakeUp(self->eventsRing);
+
+    // Process the events in place, and give the slots back to the workers
+    while ((slot = eventRingPeek(self->eventsRing))) {
+        if (!self->eventServerProcess) {
+            error("The EventServer received an event, but no EventServerProcess has been defined.");
+        }
+        else if (!self->eventServerProcess(self, slot->event.type, &slot->event)) {
+            error("Event type = %d failed.", slot->event.type);
+        }
+        eventRingRelease(self->eventsRing, slot);
+    }
+
+    return 0;
+}
+#endif
+
 static int
 eventServerSubscribe (
-    EventServer *self
+    zloop_t *loop,
+    zsock_t *eventsInput,
+    void *_self
 ) {
     zmsg_t *msg;
     zframe_t *header;
+    EventServer *self = (EventServer *) _self;
 
     // Receive the message from the publisher socket
-    if (!(msg = zmsg_recv(self->eventsInput))) {
+    if (!(msg = zmsg_recv(eventsInput))) {
         // Interrupt
         return -1;
     }
 
+    // Drop the topic frame, already filtered by the subscriber socket
+    if (!(header = zmsg_pop (msg))) {
+        error("Frame topic cannot be retrieved.");
+        return -1;
+    }
+    zframe_destroy(&header);
+
     // Get the header frame of the message
     if (!(header = zmsg_pop (msg))) {
         error("Frame header cannot be retrieved.");
@@ -237,7 +459,6 @@ eventServerSubscribe (
         case EVENT_SERVER_EVENT :
             if (!(EventServer_handleEvent (self, msg))) {
                 error("Cannot handle the event properly.");
-                return 0;
             }
         break;
 
@@ -249,56 +470,289 @@ eventServerSubscribe (
     // Cleanup
     zmsg_destroy(&msg);
 
-    return 1;
+    return 0;
 }
 
 bool
-eventServerSendToClients(
+eventServerQueueTickUpdate (
     EventServer *self,
-    zlist_t *clients,
-    zmsg_t *broadcastMsg
+    uint8_t *sessionKey,
+    EventServerTickSlot slot,
+    uint8_t *packet,
+    size_t packetLen
+) {
+    GraphNode *node;
+    GraphNodeClient *client;
+
+    if (slot >= EVENT_SERVER_TICK_SLOT_COUNT) {
+        error("The update slot %d of %s doesn't exist.", slot, sessionKey);
+        return false;
+    }
+
+    if (packetLen > EVENT_SERVER_TICK_UPDATE_MAX_SIZE) {
+        error("The update of %s is too big : %d bytes.", sessionKey, packetLen);
+        return false;
+    }
+
+    if (!(node = eventServerGetClientNode(self, sessionKey))) {
+        error("Cannot get the node %s.", sessionKey);
+        return false;
+    }
+    client = node->user_data;
+
+    if (client->id == CLIENT_ID_NONE) {
+        error("The client %s isn't on a map.", sessionKey);
+        return false;
+    }
+
+    // Only the latest update of each slot is kept, until all the clients around received it
+    if (client->tickUpdateSize == 0 && !(neighborSetAppend(&self->tickMovers, client->id))) {
+        error("Cannot queue the update of %s.", sessionKey);
+        return false;
+    }
+
+    // Remove the pending update of the slot : the new one goes after the others, so they are applied in order
+    size_t offset = 0;
+    for (size_t i = 0; i < client->tickSlotsCount; i++) {
+        EventServerTickSlot pendingSlot = client->tickSlots[i];
+        if (pendingSlot != slot) {
+            offset += client->tickSlotSizes[pendingSlot];
+            continue;
+        }
+
+        size_t pendingSize = client->tickSlotSizes[slot];
+        memmove(&client->tickUpdate[offset], &client->tickUpdate[offset + pendingSize],
+            client->tickUpdateSize - offset - pendingSize);
+        client->tickUpdateSize -= pendingSize;
+        memmove(&client->tickSlots[i], &client->tickSlots[i + 1],
+            (client->tickSlotsCount - i - 1) * sizeof(client->tickSlots[0]));
+        client->tickSlotsCount--;
+        break;
+    }
+
+    memcpy(&client->tickUpdate[client->tickUpdateSize], packet, packetLen);
+    client->tickUpdateSize += packetLen;
+    client->tickSlots[client->tickSlotsCount++] = slot;
+    client->tickSlotSizes[slot] = packetLen;
+    neighborSetClear(&client->tickReceivers);
+
+    return true;
+}
+
+static bool
+eventServerAppendTickBatch (
+    EventServer *self,
+    GraphNodeClient *observer,
+    uint8_t *update,
+    size_t updateSize
+) {
+    if (observer->tickBatchSize + updateSize > observer->tickBatchCapacity) {
+        size_t capacity = observer->tickBatchCapacity ? observer->tickBatchCapacity : EVENT_SERVER_TICK_UPDATE_MAX_SIZE * 4;
+        uint8_t *tickBatch;
+
+        while (observer->tickBatchSize + updateSize > capacity) {
+            capacity *= 2;
+        }
+
+        if (!(tickBatch = realloc(observer->tickBatch, capacity))) {
+            error("Cannot grow the tick batch.");
+            return false;
+        }
+
+        observer->tickBatch = tickBatch;
+        observer->tickBatchCapacity = capacity;
+    }
+
+    if (observer->tickBatchSize == 0 && !(neighborSetAppend(&self->tickObservers, observer->id))) {
+        error("Cannot register the observer of the tick.");
+        return false;
+    }
+
+    memcpy(&observer->tickBatch[observer->tickBatchSize], update, updateSize);
+    observer->tickBatchSize += updateSize;
+
+    return true;
+}
+
+static EventServerLodBand
+eventServerGetLodBand (
+    EventServer *self,
+    GraphNodeClient *client,
+    GraphNodeClient *observer
+) {
+    // The view area is a square : use the same distance
+    float distanceX = client->position.x - observer->position.x;
+    float distanceZ = client->position.z - observer->position.z;
+    distanceX = (distanceX < 0) ? -distanceX : distanceX;
+    distanceZ = (distanceZ < 0) ? -distanceZ : distanceZ;
+    float distance = (distanceX > distanceZ) ? distanceX : distanceZ;
+
+    if (distance < self->info.lodNearRange) {
+        return EVENT_SERVER_LOD_NEAR;
+    }
+    if (distance < self->info.lodMidRange) {
+        return EVENT_SERVER_LOD_MID;
+    }
+    return EVENT_SERVER_LOD_FAR;
+}
+
+static int
+eventServerTick (
+    zloop_t *loop,
+    int timerId,
+    void *_self
+) {
+    EventServer *self = (EventServer *) _self;
+    size_t moversCount = 0;
+    uint8_t dueBands = 0;
+
+    // A band receives the updates every (1 << band) ticks
+    self->tick++;
+    for (EventServerLodBand band = EVENT_SERVER_LOD_NEAR; band < EVENT_SERVER_LOD_COUNT; band++) {
+        if ((self->tick & ((1 << band) - 1)) == 0) {
+            dueBands |= 1 << band;
+        }
+    }
+
+    // Dispatch the latest update of each mover to the batches of the clients around it that didn't receive it yet,
+    // if their current band is due. The band of an observer can change while the update waits.
+    for (size_t i = 0; i < self->tickMovers.count; i++) {
+        GraphNode *moverNode = self->clientsById[self->tickMovers.ids[i]];
+        GraphNodeClient *mover;
+        NeighborSet *receivers;
+        size_t k = 0;
+
+        if (!moverNode || (mover = moverNode->user_data)->tickUpdateSize == 0) {
+            // The mover left during the tick
+            continue;
+        }
+
+        // Both sets are sorted : walk them together, and keep the receivers still around
+        receivers = &mover->tickReceivers;
+        neighborSetClear(&self->tickReceivers);
+        for (size_t j = 0; j < mover->neighbors.count; j++) {
+            ClientId_t observerId = mover->neighbors.ids[j];
+            GraphNodeClient *observer;
+
+            while (k < receivers->count && receivers->ids[k] < observerId) {
+                k++;
+            }
+            if (!(k < receivers->count && receivers->ids[k] == observerId)) {
+                observer = self->clientsById[observerId]->user_data;
+                if (!(dueBands & (1 << eventServerGetLodBand(self, mover, observer)))) {
+                    continue;
+                }
+                if (!(eventServerAppendTickBatch(self, observer, mover->tickUpdate, mover->tickUpdateSize))) {
+                    error("Cannot batch the update of %s.", moverNode->key);
+                }
+            }
+            if (!(neighborSetAppend(&self->tickReceivers, observerId))) {
+                error("Cannot keep the receivers of the update of %s.", moverNode->key);
+            }
+        }
+        neighborSetSwap(&mover->tickReceivers, &self->tickReceivers);
+
+        if (mover->tickReceivers.count < mover->neighbors.count) {
+            // Some clients around are still waiting for this update : keep the mover for the next ticks
+            self->tickMovers.ids[moversCount++] = mover->id;
+        } else {
+            mover->tickUpdateSize = 0;
+            mover->tickSlotsCount = 0;
+            neighborSetClear(&mover->tickReceivers);
+        }
+    }
+    self->tickMovers.count = moversCount;
+
+    // One message per observer, with all the movers it sees
+    for (size_t i = 0; i < self->tickObservers.count; i++) {
+        GraphNode *observerNode = self->clientsById[self->tickObservers.ids[i]];
+        GraphNodeClient *observer = observerNode->user_data;
+
+        if (!(eventServerMulticast(self, &observer->id, 1, observer->tickBatch, observer->tickBatchSize))) {
+            error("Cannot send the tick updates to %s.", observerNode->key);
+        }
+
+        observer->tickBatchSize = 0;
+    }
+    neighborSetClear(&self->tickObservers);
+
+    return 0;
+}
+
+static bool
+eventServerMulticast (
+    EventServer *self,
+    ClientId_t *clients,
+    size_t clientsCount,
+    uint8_t *packet,
+    size_t packetLen
 ) {
     bool result = true;
-    zmsg_t *msg = NULL;
-    zframe_t *frame = zmsg_first(broadcastMsg);
-    uint8_t *packet = zframe_data(frame);
-    size_t packetLen = zframe_size(frame);
+    BroadcastPacket *broadcast = NULL;
 
-    if ((!(msg = zmsg_new()))
-    ||  zmsg_addmem(msg, PACKET_HEADER (ROUTER_WORKER_MULTICAST), sizeof(ROUTER_WORKER_MULTICAST)) != 0
-    ||  zmsg_addmem(msg, packet, packetLen) != 0
-    ) {
+    // The packet is copied once, and shared by all the recipients down to the Router
+    if (!(broadcast = broadcastPacketNew(packet, packetLen))) {
         error("Cannot build the multicast packet.");
         result = false;
         goto cleanup;
     }
 
-    // [1 frame data] + [1 frame identity] + [1 frame identity] + ...
-    char *identityKey;
-    for (identityKey = zlist_first(clients); identityKey != NULL; identityKey = zlist_next(clients)) {
-        // Add all the clients to the packet
-        uint8_t identityBytes[5];
-        socketSessionGenId (identityKey, identityBytes);
-        if (zmsg_addmem(msg, identityBytes, sizeof(identityBytes)) != 0) {
+    for (size_t i = 0; i < clientsCount; i++) {
+        // The identity has been parsed from the session key when the node has been created
+        GraphNodeClient *client = self->clientsById[clients[i]]->user_data;
+        if (!(broadcastPacketAddRecipient(broadcast, client->identity))) {
             error("Cannot add the identity in the message.");
             result = false;
             goto cleanup;
         }
     }
 
-    if (zmsg_send(&msg, self->router) != 0) {
+    if (!(broadcastPacketSend(broadcast, self->router))) {
         error("Cannot send the multicast packet to the Router.");
         result = false;
         goto cleanup;
     }
 
 cleanup:
-    zmsg_destroy(&msg);
+    broadcastPacketDestroy(&broadcast);
     return result;
 }
 
+bool
+eventServerSendToClients (
+    EventServer *self,
+    ClientId_t *clients,
+    size_t clientsCount,
+    zmsg_t *broadcastMsg
+) {
+    zframe_t *frame = zmsg_first(broadcastMsg);
+
+    return eventServerMulticast(self, clients, clientsCount, zframe_data(frame), zframe_size(frame));
+}
+
+bool eventServerSetShardsCount(uint16_t shardsCount) {
+
+    if (shardsCount == 0 || shardsCount > EVENT_SERVER_SHARDS_MAX) {
+        error("Invalid EventServer shards count (%d), it must be in [1..%d].", shardsCount, EVENT_SERVER_SHARDS_MAX);
+        return false;
+    }
+
+    eventServerShardsCount = shardsCount;
+
+    return true;
+}
+
+uint16_t eventServerGetShardsCount(void) {
+    return eventServerShardsCount;
+}
+
+uint16_t eventServerGetMapShard(MapId_t mapId) {
+    return mapId % eventServerShardsCount;
+}
+
 bool eventServerDispatchEvent(
     zsock_t *eventServer,
+    MapId_t mapId,
     uint8_t *emitterSk,
     EventType eventType,
     void *event,
@@ -307,6 +761,24 @@ bool eventServerDispatchEvent(
     bool result = true;
     zmsg_t *msg = NULL;
 
+    #ifdef EVENT_RING_ENABLED
+    EventRing *ring;
+    EventRingSlot *slot;
+
+    // The EventServer of the shard runs in this process : write the event in place in its ring
+    if ((ring = eventServerRings[eventServerGetMapShard(mapId)])) {
+        if (!(slot = eventRingReserve(ring))) {
+            error("The events ring of the shard %d is full.", eventServerGetMapShard(mapId));
+            return false;
+        }
+        memcpy(slot->event.emitterSk, emitterSk, sizeof(slot->event.emitterSk));
+        slot->event.type = eventType;
+        memcpy(&slot->event.data, event, eventSize);
+        eventRingPublish(ring, slot, sizeof(GameEvent) - sizeof(EventDataCategories) + eventSize);
+        return true;
+    }
+    #endif
+
     GameEvent gameEvent = {
         .emitterSk = SOCKET_ID_ARRAY(emitterSk),
         .type = eventType
@@ -315,7 +787,9 @@ bool eventServerDispatchEvent(
     memcpy (&gameEvent.data, event, eventSize);
     size_t gameEventSize = sizeof(GameEvent) - sizeof (EventDataCategories) + eventSize;
 
+    // The topic frame routes the event to the shard of its map
     if ((!(msg = zmsg_new()))
+    ||  zmsg_addstrf(msg, EVENT_SERVER_TOPIC_FORMAT, eventServerGetMapShard(mapId), mapId) != 0
     ||  zmsg_addmem(msg, PACKET_HEADER (EVENT_SERVER_EVENT), sizeof(EVENT_SERVER_EVENT)) != 0
     ||  zmsg_addmem(msg, PACKET_HEADER (eventType), sizeof(eventType)) != 0
     ||  zmsg_addmem(msg, &gameEvent, gameEventSize) != 0
@@ -339,40 +813,41 @@ cleanup:
 bool
 eventServerSendToClient (
     EventServer *self,
-    uint8_t *identityKey,
+    ClientId_t client,
     uint8_t *packet,
     size_t packetLen
 ) {
-    bool result = true;
-    zmsg_t *msg = NULL;
+    return eventServerMulticast(self, &client, 1, packet, packetLen);
+}
 
-    if ((!(msg = zmsg_new()))
-    ||  zmsg_addmem(msg, PACKET_HEADER (ROUTER_WORKER_MULTICAST), sizeof(ROUTER_WORKER_MULTICAST)) != 0
-    ||  zmsg_addmem(msg, packet, packetLen) != 0
-    ) {
-        error("Cannot build the multicast packet.");
-        result = false;
-        goto cleanup;
-    }
+ClientId_t
+eventServerGetClientId (
+    EventServer *self,
+    uint8_t *sessionKey
+) {
+    GraphNode *node;
+    GraphNodeClient *client;
 
-    // Add the client identity to the packet
-    uint8_t identityBytes[5];
-    socketSessionGenId (identityKey, identityBytes);
-    if (zmsg_addmem(msg, identityBytes, sizeof(identityBytes)) != 0) {
-        error("Cannot add the identity in the message.");
-        result = false;
-        goto cleanup;
+    if (!(node = eventServerGetClientNode(self, sessionKey))) {
+        error("Cannot get the node %s.", sessionKey);
+        return CLIENT_ID_NONE;
     }
+    client = node->user_data;
 
-    if (zmsg_send(&msg, self->router) != 0) {
-        error("Cannot send the multicast packet to the Router.");
-        result = false;
-        goto cleanup;
+    if (client->id == CLIENT_ID_NONE && !(eventServerAcquireClientId(self, node))) {
+        error("Cannot give an ID to the client %s.", sessionKey);
+        return CLIENT_ID_NONE;
     }
 
-cleanup:
-    zmsg_destroy(&msg);
-    return result;
+    return client->id;
+}
+
+GraphNode *
+eventServerGetClientNodeById (
+    EventServer *self,
+    ClientId_t client
+) {
+    return self->clientsById[client];
 }
 
 uint16_t
@@ -382,20 +857,199 @@ eventServerGetRouterId (
     return self->info.routerId;
 }
 
+static MapGrid *
+eventServerGetMapGrid (
+    EventServer *self,
+    MapId_t mapId,
+    float cellSize
+) {
+    MapGrid *grid;
+    char mapKey[16];
+
+    snprintf(mapKey, sizeof(mapKey), "%x", mapId);
+
+    if (!(grid = zhash_lookup(self->mapGrids, mapKey))) {
+        // First client on this map
+        if (!(grid = mapGridNew(cellSize))) {
+            error("Cannot allocate a new grid for the map %x.", mapId);
+            return NULL;
+        }
+
+        if (zhash_insert(self->mapGrids, mapKey, grid) != 0) {
+            error("Cannot insert the grid of the map %x.", mapId);
+            mapGridDestroy(&grid);
+            return NULL;
+        }
+    }
+
+    return grid;
+}
+
 zlist_t *
-eventServerRedisGetClientsWithinRange(
+eventServerGetClientsWithinRange(
     EventServer *self,
     MapId_t mapId,
     uint8_t *ignoredSessionKey,
     PositionXZ *position,
     float range
 ) {
-    return redisGetClientsWithinDistance(self->redis, self->info.routerId, mapId, position, range, ignoredSessionKey);
+    MapGrid *grid;
+
+    if (!(grid = eventServerGetMapGrid(self, mapId, range))) {
+        error("Cannot get the grid of the map %x.", mapId);
+        return NULL;
+    }
+
+    return mapGridGetWithinRange(grid, position, range, ignoredSessionKey);
+}
+
+static bool
+eventServerAcquireClientId (
+    EventServer *self,
+    GraphNode *node
+) {
+    GraphNodeClient *client = node->user_data;
+    ClientId_t id;
+
+    if (self->freeClientIds.count > 0) {
+        id = self->freeClientIds.ids[--self->freeClientIds.count];
+    }
+    else {
+        id = self->nextClientId;
+
+        if (id >= self->clientsByIdCapacity) {
+            size_t capacity = self->clientsByIdCapacity ? self->clientsByIdCapacity * 2 : 256;
+            GraphNode **clientsById;
+
+            if (!(clientsById = realloc(self->clientsById, capacity * sizeof(GraphNode *)))) {
+                error("Cannot grow the clients table.");
+                return false;
+            }
+
+            self->clientsById = clientsById;
+            self->clientsByIdCapacity = capacity;
+        }
+
+        self->nextClientId++;
+    }
+
+    self->clientsById[id] = node;
+    client->id = id;
+
+    return true;
+}
+
+static void
+eventServerReleaseClientId (
+    EventServer *self,
+    GraphNode *node
+) {
+    GraphNodeClient *client = node->user_data;
+
+    if (client->id == CLIENT_ID_NONE) {
+        return;
+    }
+
+    // Drop the pending update : the ID may be given to another client before the next tick
+    if (client->tickUpdateSize != 0) {
+        for (size_t i = 0; i < self->tickMovers.count; i++) {
+            if (self->tickMovers.ids[i] == client->id) {
+                self->tickMovers.ids[i] = self->tickMovers.ids[--self->tickMovers.count];
+                break;
+            }
+        }
+        client->tickUpdateSize = 0;
+        client->tickSlotsCount = 0;
+        neighborSetClear(&client->tickReceivers);
+    }
+
+    self->clientsById[client->id] = NULL;
+    if (!(neighborSetAppend(&self->freeClientIds, client->id))) {
+        // The ID is lost, but won't be given to another client
+        warning("Cannot release the client ID %u.", client->id);
+    }
+    client->id = CLIENT_ID_NONE;
+}
+
+bool
+eventServerUpdateClientPosition(
+    EventServer *self,
+    MapId_t mapId,
+    uint8_t *sessionKey,
+    PositionXYZ *position,
+    float range,
+    NeighborSet **_clientsAround,
+    NeighborSet **_enteredClients,
+    NeighborSet **_leftClients
+) {
+    GraphNode *node;
+    GraphNodeClient *client;
+    MapGrid *grid;
+    PositionXZ center = PositionXYZToXZ(position);
+
+    if (!(node = eventServerGetClientNode(self, sessionKey))) {
+        error("Cannot get the node %s.", sessionKey);
+        return false;
+    }
+    client = node->user_data;
+
+    if (client->id == CLIENT_ID_NONE && !(eventServerAcquireClientId(self, node))) {
+        error("Cannot give an ID to the client %s.", sessionKey);
+        return false;
+    }
+
+    if (!(grid = eventServerGetMapGrid(self, mapId, range))) {
+        error("Cannot get the grid of the map %x.", mapId);
+        return false;
+    }
+
+    // The client changed of map
+    if (client->grid && client->grid != grid) {
+        mapGridRemove(client->grid, sessionKey);
+    }
+    client->grid = grid;
+
+    if (!(mapGridUpdate(grid, sessionKey, client->id, &center))) {
+        error("Cannot update the position of %s in the grid.", sessionKey);
+        return false;
+    }
+    client->position = center;
+
+    // Compare the clients around to the previous visible set, with a single merge
+    if (!(mapGridGetIdsWithinRange(grid, &center, range, sessionKey, &self->aroundIds))
+    ||  !(neighborSetDiff(&client->neighbors, &self->aroundIds, &self->enteredIds, &self->leftIds))) {
+        error("Cannot compute the visible set of %s.", sessionKey);
+        return false;
+    }
+
+    // The visibility is mutual : update the visible set of the neighbors too
+    for (size_t i = 0; i < self->enteredIds.count; i++) {
+        GraphNode *neighbourNode = self->clientsById[self->enteredIds.ids[i]];
+        GraphNodeClient *neighbourClient = neighbourNode->user_data;
+        eventServerLinkClients(self, node, neighbourNode);
+        neighborSetInsert(&neighbourClient->neighbors, client->id);
+    }
+
+    for (size_t i = 0; i < self->leftIds.count; i++) {
+        GraphNode *neighbourNode = self->clientsById[self->leftIds.ids[i]];
+        GraphNodeClient *neighbourClient = neighbourNode->user_data;
+        eventServerUnlinkClients(self, node, neighbourNode);
+        neighborSetRemove(&neighbourClient->neighbors, client->id);
+    }
+
+    neighborSetSwap(&client->neighbors, &self->aroundIds);
+
+    *_clientsAround = &client->neighbors;
+    *_enteredClients = &self->enteredIds;
+    *_leftClients = &self->leftIds;
+
+    return true;
 }
 
 bool eventServerRemoveClient(EventServer *self, uint8_t *sessionKey)
 {
     GraphNode *node;
+    GraphNodeClient *client;
 
     // Get the node associated with the sessionKey
     if (!(node = eventServerGetClientNode (self, sessionKey))) {
@@ -403,6 +1057,21 @@ bool eventServerRemoveClient(EventServer *self, uint8_t *sessionKey)
         return false;
     }
 
+    // Remove it from the grid of its map, and from the visible sets of its neighbors
+    client = node->user_data;
+    if (client->grid) {
+        mapGridRemove(client->grid, sessionKey);
+        client->grid = NULL;
+    }
+
+    for (size_t i = 0; i < client->neighbors.count; i++) {
+        GraphNode *neighbourNode = self->clientsById[client->neighbors.ids[i]];
+        GraphNodeClient *neighbourClient = neighbourNode->user_data;
+        neighborSetRemove(&neighbourClient->neighbors, client->id);
+    }
+    neighborSetClear(&client->neighbors);
+    eventServerReleaseClientId(self, node);
+
     if (!(graphRemoveNode(self->clientsGraph, node))) {
         error ("Cannot remove a client '%s' from the graph.", sessionKey);
         return false;
@@ -412,42 +1081,58 @@ bool eventServerRemoveClient(EventServer *self, uint8_t *sessionKey)
 }
 
 bool
-eventServerGetClientsAround (
+eventServerGetClientIdsAround (
     EventServer *self,
     uint8_t *sessionKey,
-    zlist_t **_clients
+    EventServerLodBand maxBand,
+    bool withSelf,
+    NeighborSet **_clients
 ) {
-    bool status = true;
     GraphNode *node;
-    zlist_t *clients = NULL;
+    GraphNodeClient *client;
+    NeighborSet *clients = &self->fanOutIds;
 
-    if (!(clients = zlist_new())) {
-        error("Cannot allocate a new clients list.");
-        status = false;
-        goto cleanup;
-    }
+    neighborSetClear(clients);
     *_clients = clients;
 
     // Get the node associated with the sessionKey
     if (!(node = eventServerGetClientNode (self, sessionKey))) {
         error("Cannot get the node %s.", sessionKey);
-        return NULL;
+        return false;
+    }
+    client = node->user_data;
+
+    // The client needs a compact ID to receive the packet too
+    if (withSelf) {
+        if ((client->id == CLIENT_ID_NONE && !(eventServerAcquireClientId(self, node)))
+        ||  !(neighborSetAppend(clients, client->id))) {
+            error("Cannot add the client %s to the recipients.", sessionKey);
+            return false;
+        }
     }
 
-    // Add the neighbors keys to the clients list
-    for (GraphArc *arc = zlist_first(node->arcs); arc != NULL; arc = zlist_next(node->arcs)) {
-        GraphNode *nodeAround = arc->to;
-        zlist_append(clients, nodeAround->key);
+    // Add the neighbors close enough to the recipients
+    for (size_t i = 0; i < client->neighbors.count; i++) {
+        ClientId_t neighbourId = client->neighbors.ids[i];
+        GraphNodeClient *neighbourClient = self->clientsById[neighbourId]->user_data;
+        if (maxBand >= EVENT_SERVER_LOD_FAR || eventServerGetLodBand(self, client, neighbourClient) <= maxBand) {
+            if (!(neighborSetAppend(clients, neighbourId))) {
+                error("Cannot add a neighbour of %s to the recipients.", sessionKey);
+                return false;
+            }
+        }
     }
 
-cleanup:
-    return status;
+    return true;
 }
 
 bool
 eventServerStart (
     EventServer *self
 ) {
+    bool status = false;
+    zloop_t *reactor = NULL;
+
     // Start Redis
     if (!(redisConnection (self->redis))) {
         error("Cannot connect to the Redis Server.");
@@ -455,7 +1140,7 @@ eventServerStart (
     }
 
     // Bind the connection to the router
-    if (zsock_bind(self->router, ROUTER_SUBSCRIBER_ENDPOINT, self->info.routerId) != 0) {
+    if (zsock_bind(self->router, ROUTER_SUBSCRIBER_ENDPOINT, self->info.routerId, self->info.shardId) != 0) {
         error("Failed to bind to the subscriber endpoint.");
         return false;
     }
@@ -477,16 +1162,53 @@ eventServerStart (
     }
     info("EventServer subscribed to %s", zsys_sprintf(EVENT_SERVER_MONITOR_ENDPOINT, self->info.routerId));
 
-    // Subscribe to all messages, without any filter
-    zsock_set_subscribe(self->eventsInput, "");
+    // Subscribe only to the events of the maps of this shard
+    char *topic;
+    if (!(topic = zsys_sprintf(EVENT_SERVER_SHARD_TOPIC_FORMAT, self->info.shardId))) {
+        error("Cannot build the topic of the shard %d.", self->info.shardId);
+        return false;
+    }
+    zsock_set_subscribe(self->eventsInput, topic);
+    info("EventServer shard %d/%d started.", self->info.shardId + 1, eventServerShardsCount);
+    zstr_free(&topic);
 
-    // Listen to the subscriber socket
-    while (eventServerSubscribe (self) != -1) {
-        // Things to do between two messages ?
+    // Listen to the subscriber socket, and flush the aggregated updates at each tick
+    if (!(reactor = zloop_new())) {
+        error("Cannot allocate a new reactor.");
+        goto cleanup;
+    }
+
+    if (zloop_reader(reactor, self->eventsInput, eventServerSubscribe, self) == -1
+    ||  zloop_timer(reactor, EVENT_SERVER_TICK_DELAY, 0, eventServerTick, self) == -1
+    ) {
+        error("Cannot register the subscriber and the tick with the reactor.");
+        goto cleanup;
     }
 
+    // The workers of this process write their events in the ring, and signal its eventfd
+    #ifdef EVENT_RING_ENABLED
+    zmq_pollitem_t ringItem = {
+        .socket = NULL,
+        .fd = eventRingGetFd(self->eventsRing),
+        .events = ZMQ_POLLIN
+    };
+    if (zloop_poller(reactor, &ringItem, eventServerReadRing, self) == -1) {
+        error("Cannot register the events ring with the reactor.");
+        goto cleanup;
+    }
+    #endif
+
+    if (zloop_start(reactor) != 0) {
+        error("An error occurred in the reactor.");
+        goto cleanup;
+    }
+
+    status = true;
+
+cleanup:
+    zloop_destroy(&reactor);
     info("EventServer exits...");
-    return true;
+    return status;
 }
 
 bool
@@ -514,15 +1236,26 @@ eventServerGetClientNode (
 ) {
     GraphNode *clientNode;
 
-    if (!(clientNode = graphGetNode (self->clientsGraph, sessionKey))) {
+    if (!(clientNode = graphGetNode (self->clientsGraph, (char *) sessionKey))) {
         // Client node doesn't exist, create it
         info("Add client %s in the graph", sessionKey);
-        if (!(clientNode = graphNodeNew (sessionKey, NULL))) {
+        if (!(clientNode = graphNodeNew ((char *) sessionKey, NULL))) {
             error("Cannot allocate a new client node.");
             return NULL;
         }
 
-        clientNode->user_data = graphNodeClientNew ();
+        GraphNodeClient *client;
+        if (!(client = graphNodeClientNew ())) {
+            error("Cannot allocate a new client.");
+            graphNodeDestroy (&clientNode);
+            return NULL;
+        }
+
+        // Parse the identity once, instead of each time a packet is sent to the client
+        socketSessionGenId (sessionKey, client->identity);
+        client->routerId = self->info.routerId;
+        clientNode->user_data = client;
+
         // Add it to the hashtable
         if (!(graphInsertNode (self->clientsGraph, clientNode))) {
             error("Cannot insert a new client node.");
@@ -558,7 +1291,10 @@ void
 graphNodeClientFree (
     GraphNodeClient *self
 ) {
-    // TODO
+    neighborSetFree(&self->neighbors);
+    neighborSetFree(&self->tickReceivers);
+    free(self->tickBatch);
+    free(self->appearance);
 }
 
 void
@@ -20,11 +20,45 @@
 #include "common/graph/graph.h"
 #include "common/session/session.h"
 #include "common/server/router.h"
+#include "common/server/map_grid.h"
+#include "common/server/neighbor_set.h"
 
 #define EVENT_SERVER_EXECUTABLE_NAME             "EventServer"
 #define EVENT_SERVER_SUBSCRIBER_ENDPOINT         "inproc://eventServerWorkersSubscriber-%d-%d"
 #define EVENT_SERVER_MONITOR_ENDPOINT            "inproc://eventServerMonitorSubscriber-%d"
 
+// The events are processed by several EventServer threads, each one owning the maps of a shard.
+// Every event is published with a topic containing its shard and mapId, and each shard subscribes to its own prefix.
+// The number of shards of a process is read from the server configuration.
+#define EVENT_SERVER_SHARDS_MAX                  16
+#define EVENT_SERVER_SHARDS_COUNT_DEFAULT        4
+#define EVENT_SERVER_SHARD_TOPIC_FORMAT          "shard%02x:"
+#define EVENT_SERVER_TOPIC_FORMAT                EVENT_SERVER_SHARD_TOPIC_FORMAT "map%x"
+
+// The state updates of the clients are aggregated, and sent to the clients around at a fixed rate
+#define EVENT_SERVER_TICK_RATE                   15
+#define EVENT_SERVER_TICK_DELAY                  (1000 / EVENT_SERVER_TICK_RATE)
+#define EVENT_SERVER_TICK_UPDATE_MAX_SIZE        128
+
+// Kinds of state updates of a client : only the latest update of each kind is kept during a tick
+typedef enum EventServerTickSlot {
+    EVENT_SERVER_TICK_SLOT_MOVE,
+    EVENT_SERVER_TICK_SLOT_ROTATE,
+    EVENT_SERVER_TICK_SLOT_HEAD_ROTATE,
+    EVENT_SERVER_TICK_SLOT_COUNT
+}   EventServerTickSlot;
+
+// Distance bands of the observers of a client, sorted from the nearest to the farthest
+// The farther an observer is, the less often it receives the updates of the client
+#define EVENT_SERVER_LOD_NEAR_RANGE_DEFAULT      100.0
+#define EVENT_SERVER_LOD_MID_RANGE_DEFAULT       175.0
+typedef enum EventServerLodBand {
+    EVENT_SERVER_LOD_NEAR,  // every tick
+    EVENT_SERVER_LOD_MID,   // every 2 ticks
+    EVENT_SERVER_LOD_FAR,   // every 4 ticks
+    EVENT_SERVER_LOD_COUNT
+}   EventServerLodBand;
+
 /** Enumeration of all the packets headers that the EventServer handles */
 // we want to differentiate the headers being received from the the ones being send, but we also want to keep a list
 // with uniques header IDs. So, let's declare all the IDs here, and distribute them afterward
@@ -67,6 +101,8 @@ typedef enum EventType {
     EVENT_TYPE_ROTATE,
     EVENT_TYPE_LEAVE,
     EVENT_TYPE_POSE,
+    EVENT_TYPE_WARP,
+    EVENT_TYPE_APPEARANCE_CHANGE,
     EVENT_TYPE_ZONE_END,
 
     // Barrack Events
@@ -81,12 +117,49 @@ typedef enum EventType {
 
 typedef struct {
     RouterId_t routerId;
+    uint16_t shardId;
     uint16_t workersCount;
     RedisInfo redisInfo;
+
+    // upper distances of the near and mid LOD bands
+    float lodNearRange;
+    float lodMidRange;
 } EventServerInfo;
 
 typedef struct {
-    bool around;
+    // compact ID of the client while it is on a map, or CLIENT_ID_NONE
+    ClientId_t id;
+
+    // identity of the client socket, and the Router handling it, parsed once from the session key
+    uint8_t identity[SOCKET_SESSION_IDENTITY_SIZE];
+    RouterId_t routerId;
+
+    // sorted IDs of the clients around
+    NeighborSet neighbors;
+
+    // grid of the map where the client is, or NULL
+    MapGrid *grid;
+
+    // last known position of the client
+    PositionXZ position;
+
+    // latest state update of each slot, in the order they have been queued,
+    // and the sorted IDs of the clients around that already received them
+    uint8_t tickUpdate[EVENT_SERVER_TICK_SLOT_COUNT * EVENT_SERVER_TICK_UPDATE_MAX_SIZE];
+    size_t tickUpdateSize;
+    EventServerTickSlot tickSlots[EVENT_SERVER_TICK_SLOT_COUNT];
+    size_t tickSlotsCount;
+    size_t tickSlotSizes[EVENT_SERVER_TICK_SLOT_COUNT];
+    NeighborSet tickReceivers;
+
+    // updates of the clients around, to be sent to the client at the end of the current tick
+    uint8_t *tickBatch;
+    size_t tickBatchSize;
+    size_t tickBatchCapacity;
+
+    // appearance of the client sent once by the workers, or NULL
+    void *appearance;
+    size_t appearanceSize;
 } GraphNodeClient;
 
 typedef struct EventServer EventServer;
@@ -175,59 +248,135 @@ bool eventServerUnlinkClients(EventServer *self, GraphNode *node1, GraphNode *no
  * @brief Initialize an allocated EventServerInfo structure.
  * @param self An allocated EventServerInfo to initialize.
  * @param routerId The routerID
+ * @param shardId The shard of maps handled by the EventServer, in [0..eventServerGetShardsCount()[
  * @param workersCount The workers count
+ * @param redisHostname The IP address of the Redis server
+ * @param redisPort The port of the Redis server
+ * @param redisPoolSize The number of Redis connections shared by the process
+ * @param lodNearRange The upper distance of the near LOD band
+ * @param lodMidRange The upper distance of the mid LOD band
  * @return true on success, false otherwise.
  */
 bool eventServerInfoInit(
     EventServerInfo *self,
     RouterId_t routerId,
+    uint16_t shardId,
     uint16_t workersCount,
     char *redisHostname,
-    int redisPort);
+    int redisPort,
+    int redisPoolSize,
+    float lodNearRange,
+    float lodMidRange);
 
 /**
- * @brief Return a list of clients around a given player
+ * @brief Return the compact IDs of the clients around a given player, up to a given LOD band.
+ *        The set is reused by the next call, it must not be kept.
  * @param self An allocated EventServer
  * @param sessionKey The player sessionKey
- * @param[out] _clients The result list of clients socketIds
+ * @param maxBand The farthest LOD band included
+ * @param withSelf true to include the player in the set
+ * @param[out] _clients The compact IDs of the clients
  * @return true on success, false otherwise
  */
-bool eventServerGetClientsAround(
+bool eventServerGetClientIdsAround(
     EventServer *self,
     uint8_t *sessionKey,
-    zlist_t **_clients);
+    EventServerLodBand maxBand,
+    bool withSelf,
+    NeighborSet **_clients);
 
 /**
  * @brief Send the same packet to multiple clients
  * @param self An allocated EventServer
- * @param clients A list of clients socket identity
+ * @param clients The compact IDs of the clients
+ * @param clientsCount The number of clients
  * @param msg the message to broadcast
  * @return true on success, false otherwise
  */
 bool eventServerSendToClients(
     EventServer *self,
-    zlist_t *clients,
+    ClientId_t *clients,
+    size_t clientsCount,
     zmsg_t *msg);
 
+/**
+ * @brief Queue the latest state update of a client. It replaces the update of the same slot that is still pending,
+ *        and is sent to the clients around at the end of the tick, batched with the updates of the other clients.
+ * @param self An allocated EventServer
+ * @param sessionKey The socketID of the client, that must be on a map
+ * @param slot The kind of the update
+ * @param packet The update packet
+ * @param packetLen the length of the packet
+ * @return true on success, false otherwise
+ */
+bool eventServerQueueTickUpdate(
+    EventServer *self,
+    uint8_t *sessionKey,
+    EventServerTickSlot slot,
+    uint8_t *packet,
+    size_t packetLen);
+
 /**
  * @brief Send a packet to one client
  * @param self An allocated EventServer
- * @param identityKey A socket identity
+ * @param client The compact ID of the client
  * @param packet The packet to send
  * @param packetLen the length of the packet
  * @return true on success, false otherwise
  */
 bool eventServerSendToClient(
     EventServer *self,
-    uint8_t *identityKey,
+    ClientId_t client,
     uint8_t *packet,
     size_t packetLen);
 
+/**
+ * @brief Get the compact ID of a client, and give it one if it doesn't have any yet
+ * @param self An allocated EventServer
+ * @param sessionKey The socketID of the client
+ * @return the compact ID of the client, or CLIENT_ID_NONE on error
+ */
+ClientId_t eventServerGetClientId(EventServer *self, uint8_t *sessionKey);
+
+/**
+ * @brief Get the node of a client from its compact ID, without any hashtable lookup
+ * @param self An allocated EventServer
+ * @param client The compact ID of the client
+ * @return the node of the client
+ */
+GraphNode *eventServerGetClientNodeById(EventServer *self, ClientId_t client);
+
 /**
  * @brief : Router ID Accessor
  */
 uint16_t eventServerGetRouterId(EventServer *self);
 
+/**
+ * @brief Keep the appearance of a client, so the events don't need to carry it
+ * @param self An allocated EventServer
+ * @param sessionKey The socketID of the client
+ * @param appearance The appearance of the client, copied in the EventServer
+ * @param appearanceSize The size of the appearance
+ * @return true on success, false otherwise
+ */
+bool eventServerSetClientAppearance(
+    EventServer *self,
+    uint8_t *sessionKey,
+    void *appearance,
+    size_t appearanceSize);
+
+/**
+ * @brief Get the appearance of a client kept by the EventServer
+ * @param self An allocated EventServer
+ * @param sessionKey The socketID of the client
+ * @param[out] appearanceSize The size of the appearance
+ * @return the appearance of the client, or NULL if it isn't known
+ */
+void *eventServerGetClientAppearance(
+    EventServer *self,
+    uint8_t *sessionKey,
+    size_t *appearanceSize);
+
 /**
  * @brief : GameSessionBySocketId by Redis module Accessor
  */
@@ -251,16 +400,16 @@ GraphNode *eventServerGetClientNode(EventServer *self, uint8_t *socketId);
 
 
 /**
- * @brief Return a list of clients into an area according to the Redis database
+ * @brief Return a list of clients into an area, according to the grid of the map
  * @param self An allocated EventServer
  * @param mapId : The mapId of the target zone
  * @param ignoredSessionKey A socketID to ignore. NULL don't ignore anybody.
- * @param center The position of the center of the circle
- * @param range Radius of the circle
+ * @param center The position of the center of the area
+ * @param range Half width of the area
  * @return a zlist_t of identity keys
  */
 zlist_t *
-eventServerRedisGetClientsWithinRange(
+eventServerGetClientsWithinRange(
     EventServer *self,
     MapId_t mapId,
     uint8_t *ignoredSessionKey,
@@ -269,10 +418,58 @@ eventServerRedisGetClientsWithinRange(
 );
 
 /**
- * @brief Send an event to the event server socket
+ * @brief Update the position of a client in the grid of its map, and return the clients around it.
+ *        The clients entering and leaving its view are linked and unlinked in the clients graph.
+ *        The grid of a map is created by its first update, with the range as cell size.
+ * @param self An allocated EventServer
+ * @param mapId : The mapId of the client
+ * @param sessionKey The socketID of the client, not included in the results
+ * @param position The new position of the client
+ * @param range Half width of the area
+ * @param[out] _clientsAround The compact IDs of the clients around
+ * @param[out] _enteredClients The compact IDs of the clients that entered the view of the client
+ * @param[out] _leftClients The compact IDs of the clients that left the view of the client
+ * @return true on success, false otherwise. The sets are owned by the EventServer, until its next update.
+ */
+bool
+eventServerUpdateClientPosition(
+    EventServer *self,
+    MapId_t mapId,
+    uint8_t *sessionKey,
+    PositionXYZ *position,
+    float range,
+    NeighborSet **_clientsAround,
+    NeighborSet **_enteredClients,
+    NeighborSet **_leftClients
+);
+
+/**
+ * @brief Set the number of EventServer shards of the process. Must be called before the servers start.
+ * @param shardsCount The number of shards, in [1..EVENT_SERVER_SHARDS_MAX]
+ * @return true on success, false otherwise
+ */
+bool eventServerSetShardsCount(uint16_t shardsCount);
+
+/**
+ * @brief Get the number of EventServer shards of the process
+ * @return the number of shards
+ */
+uint16_t eventServerGetShardsCount(void);
+
+/**
+ * @brief Get the EventServer shard handling a given map
+ * @param mapId The mapId
+ * @return the shard ID of the map
+ */
+uint16_t eventServerGetMapShard(MapId_t mapId);
+
+/**
+ * @brief Send an event to the event server socket.
+ *        Only the EventServer shard of the map of the emitter receives it.
  */
 bool eventServerDispatchEvent(
     zsock_t *eventServer,
+    MapId_t mapId,
     uint8_t *emitterSk,
     EventType eventType,
     void *event,
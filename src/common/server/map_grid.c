@@ -0,0 +1,453 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "map_grid.h"
+#include "common/session/socket_session.h"
+
+
+// ------ Structure declaration -------
+/**
+ * @brief MapGridEntity is a client located in a cell
+ */
+typedef struct MapGridEntity {
+    // socket ID of the client
+    char key[SOCKET_SESSION_ID_SIZE];
+
+    // compact ID of the client
+    ClientId_t id;
+
+    // last known position
+    PositionXZ position;
+
+    // coordinates of the cell containing the client
+    int32_t cellX, cellZ;
+
+    // index of the client in the entities of its cell
+    size_t slot;
+} MapGridEntity;
+
+/**
+ * @brief MapGridCell is an unordered array of the clients located in a square of the map
+ */
+typedef struct MapGridCell {
+    // coordinates of the cell
+    int32_t x, z;
+
+    // the slot of the cell is used
+    bool used;
+
+    // clients in the cell
+    MapGridEntity **entities;
+    size_t count;
+    size_t capacity;
+} MapGridCell;
+
+/**
+ * @brief MapGrid is a spatial hash of cells, with open addressing
+ */
+struct MapGrid {
+    // width of a cell
+    float cellSize;
+
+    // cells hashtable
+    MapGridCell *cells;
+    size_t cellsCapacity;
+    size_t cellsCount;
+
+    // hashtable of MapGridEntity, by socket ID
+    zhash_t *entities;
+};
+
+
+// ------ Static declaration -------
+/**
+ * @brief Return the coordinate of the cell containing a position coordinate
+ */
+static inline int32_t mapGridCellCoord(MapGrid *self, float position);
+
+/**
+ * @brief Get the cell at the given coordinates
+ * @param self An allocated MapGrid
+ * @param x, z The coordinates of the cell
+ * @param create Create the cell if it doesn't exist yet
+ * @return the cell, or NULL if it doesn't exist or cannot be created
+ */
+static MapGridCell *mapGridGetCell(MapGrid *self, int32_t x, int32_t z, bool create);
+
+/**
+ * @brief Double the capacity of the cells hashtable
+ * @return true on success, false otherwise
+ */
+static bool mapGridGrow(MapGrid *self);
+
+/**
+ * @brief Call a visitor for each client into the square area around a given position.
+ *        Only the cells covering the area are scanned.
+ * @param self An allocated MapGrid
+ * @param center The 2D position of the center of the area
+ * @param range Half width of the area
+ * @param ignoredKey if not NULL, don't visit this socketId
+ * @param visit The visitor. Stops the visit when it returns false.
+ * @param arg The user argument of the visitor
+ * @return true if all the clients have been visited, false otherwise
+ */
+static bool mapGridVisitWithinRange(
+    MapGrid *self, PositionXZ *center, float range, uint8_t *ignoredKey,
+    bool (*visit)(MapGridEntity *entity, void *arg), void *arg);
+
+/**
+ * @brief Visitors appending the key, or the ID, of a client to a collection
+ */
+static bool mapGridVisitAppendKey(MapGridEntity *entity, void *clients);
+static bool mapGridVisitAppendId(MapGridEntity *entity, void *ids);
+
+/**
+ * @brief Add a client to a cell
+ * @return true on success, false otherwise
+ */
+static bool mapGridCellAdd(MapGridCell *cell, MapGridEntity *entity);
+
+/**
+ * @brief Remove a client from a cell
+ */
+static void mapGridCellRemove(MapGridCell *cell, MapGridEntity *entity);
+
+
+// ------ Extern function implementation -------
+
+MapGrid *mapGridNew(float cellSize) {
+    MapGrid *self;
+
+    if ((self = calloc(1, sizeof(MapGrid))) == NULL) {
+        return NULL;
+    }
+
+    if (!mapGridInit(self, cellSize)) {
+        mapGridDestroy(&self);
+        error("MapGrid failed to initialize.");
+        return NULL;
+    }
+
+    return self;
+}
+
+bool mapGridInit(MapGrid *self, float cellSize) {
+
+    if (cellSize <= 0) {
+        error("Invalid cell size : %f", cellSize);
+        return false;
+    }
+
+    self->cellSize = cellSize;
+    self->cellsCount = 0;
+    self->cellsCapacity = MAP_GRID_CELLS_DEFAULT_CAPACITY;
+
+    if (!(self->cells = calloc(self->cellsCapacity, sizeof(MapGridCell)))) {
+        error("Cannot allocate the cells of the grid.");
+        return false;
+    }
+
+    if (!(self->entities = zhash_new())) {
+        error("Cannot allocate a new hashtable for the entities.");
+        return false;
+    }
+
+    return true;
+}
+
+bool mapGridUpdate(MapGrid *self, uint8_t *key, ClientId_t id, PositionXZ *position) {
+
+    MapGridEntity *entity;
+    MapGridCell *cell;
+    int32_t cellX = mapGridCellCoord(self, position->x);
+    int32_t cellZ = mapGridCellCoord(self, position->z);
+
+    if ((entity = zhash_lookup(self->entities, (char *) key))) {
+        entity->id = id;
+        entity->position = *position;
+
+        if (entity->cellX == cellX && entity->cellZ == cellZ) {
+            // Still in the same cell
+            return true;
+        }
+
+        if ((cell = mapGridGetCell(self, entity->cellX, entity->cellZ, false))) {
+            mapGridCellRemove(cell, entity);
+        }
+    }
+    else {
+        // New client in the grid
+        if (!(entity = calloc(1, sizeof(MapGridEntity)))) {
+            error("Cannot allocate a new grid entity.");
+            return false;
+        }
+
+        strncpy(entity->key, (char *) key, sizeof(entity->key) - 1);
+        entity->id = id;
+        entity->position = *position;
+
+        if (zhash_insert(self->entities, (char *) key, entity) != 0) {
+            error("Cannot insert the client '%s' in the grid.", key);
+            free(entity);
+            return false;
+        }
+        zhash_freefn(self->entities, (char *) key, free);
+    }
+
+    entity->cellX = cellX;
+    entity->cellZ = cellZ;
+
+    if (!(cell = mapGridGetCell(self, cellX, cellZ, true))
+    ||  !(mapGridCellAdd(cell, entity))) {
+        error("Cannot add the client '%s' to its cell.", key);
+        zhash_delete(self->entities, (char *) key);
+        return false;
+    }
+
+    return true;
+}
+
+bool mapGridRemove(MapGrid *self, uint8_t *key) {
+
+    MapGridEntity *entity;
+    MapGridCell *cell;
+
+    if (!(entity = zhash_lookup(self->entities, (char *) key))) {
+        return false;
+    }
+
+    if ((cell = mapGridGetCell(self, entity->cellX, entity->cellZ, false))) {
+        mapGridCellRemove(cell, entity);
+    }
+
+    zhash_delete(self->entities, (char *) key);
+
+    return true;
+}
+
+zlist_t *mapGridGetWithinRange(MapGrid *self, PositionXZ *center, float range, uint8_t *ignoredKey) {
+
+    zlist_t *clients;
+
+    if (!(clients = zlist_new())) {
+        error("Cannot allocate a new zlist.");
+        return NULL;
+    }
+    zlist_autofree(clients);
+
+    if (!(mapGridVisitWithinRange(self, center, range, ignoredKey, mapGridVisitAppendKey, clients))) {
+        zlist_destroy(&clients);
+        return NULL;
+    }
+
+    return clients;
+}
+
+bool mapGridGetIdsWithinRange(MapGrid *self, PositionXZ *center, float range, uint8_t *ignoredKey, NeighborSet *ids) {
+
+    neighborSetClear(ids);
+
+    if (!(mapGridVisitWithinRange(self, center, range, ignoredKey, mapGridVisitAppendId, ids))) {
+        error("Cannot build the list of the clients around.");
+        return false;
+    }
+
+    neighborSetSort(ids);
+
+    return true;
+}
+
+size_t mapGridSize(MapGrid *self) {
+    return zhash_size(self->entities);
+}
+
+void mapGridFree(MapGrid *self) {
+
+    if (self->cells) {
+        for (size_t i = 0; i < self->cellsCapacity; i++) {
+            free(self->cells[i].entities);
+        }
+        free(self->cells);
+    }
+
+    zhash_destroy(&self->entities);
+}
+
+void mapGridDestroy(MapGrid **_self) {
+    MapGrid *self = *_self;
+
+    if (self) {
+        mapGridFree(self);
+        free(self);
+    }
+
+    *_self = NULL;
+}
+
+
+// ------ Static function implementation -------
+
+static inline int32_t mapGridCellCoord(MapGrid *self, float position) {
+    return (int32_t) floorf(position / self->cellSize);
+}
+
+static inline size_t mapGridHash(int32_t x, int32_t z) {
+    // Fibonacci hashing of both coordinates
+    uint64_t hash = ((uint64_t) (uint32_t) x << 32) | (uint32_t) z;
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return (size_t) (hash >> 32);
+}
+
+static MapGridCell *mapGridGetCell(MapGrid *self, int32_t x, int32_t z, bool create) {
+
+    size_t mask = self->cellsCapacity - 1;
+    size_t index = mapGridHash(x, z) & mask;
+
+    // Linear probing
+    while (self->cells[index].used) {
+        MapGridCell *cell = &self->cells[index];
+        if (cell->x == x && cell->z == z) {
+            return cell;
+        }
+        index = (index + 1) & mask;
+    }
+
+    if (!create) {
+        return NULL;
+    }
+
+    // Keep the load factor under 1/2, so the probing sequences stay short
+    if ((self->cellsCount + 1) * 2 > self->cellsCapacity) {
+        if (!(mapGridGrow(self))) {
+            return NULL;
+        }
+        return mapGridGetCell(self, x, z, true);
+    }
+
+    // Cells are never removed : the cells of a map are bounded by the area its clients went through
+    MapGridCell *cell = &self->cells[index];
+    cell->used = true;
+    cell->x = x;
+    cell->z = z;
+    self->cellsCount++;
+
+    return cell;
+}
+
+static bool mapGridGrow(MapGrid *self) {
+
+    MapGridCell *oldCells = self->cells;
+    size_t oldCapacity = self->cellsCapacity;
+    size_t capacity = oldCapacity * 2;
+    MapGridCell *cells;
+
+    if (!(cells = calloc(capacity, sizeof(MapGridCell)))) {
+        error("Cannot grow the cells of the grid.");
+        return false;
+    }
+
+    // Entities only refer to the coordinates of their cell, so the cells can be moved
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (!oldCells[i].used) {
+            continue;
+        }
+        size_t index = mapGridHash(oldCells[i].x, oldCells[i].z) & (capacity - 1);
+        while (cells[index].used) {
+            index = (index + 1) & (capacity - 1);
+        }
+        cells[index] = oldCells[i];
+    }
+
+    self->cells = cells;
+    self->cellsCapacity = capacity;
+    free(oldCells);
+
+    return true;
+}
+
+static bool mapGridVisitWithinRange(
+    MapGrid *self, PositionXZ *center, float range, uint8_t *ignoredKey,
+    bool (*visit)(MapGridEntity *entity, void *arg), void *arg)
+{
+    int32_t minX = mapGridCellCoord(self, center->x - range);
+    int32_t maxX = mapGridCellCoord(self, center->x + range);
+    int32_t minZ = mapGridCellCoord(self, center->z - range);
+    int32_t maxZ = mapGridCellCoord(self, center->z + range);
+
+    for (int32_t x = minX; x <= maxX; x++) {
+        for (int32_t z = minZ; z <= maxZ; z++) {
+            MapGridCell *cell;
+
+            if (!(cell = mapGridGetCell(self, x, z, false))) {
+                continue;
+            }
+
+            for (size_t i = 0; i < cell->count; i++) {
+                MapGridEntity *entity = cell->entities[i];
+
+                if (!(mathIsWithin2DManhattanDistance(&entity->position, center, range))) {
+                    continue;
+                }
+
+                // Don't include the ignored socketId
+                if (ignoredKey && strcmp(entity->key, (char *) ignoredKey) == 0) {
+                    continue;
+                }
+
+                if (!(visit(entity, arg))) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool mapGridVisitAppendKey(MapGridEntity *entity, void *clients) {
+    return zlist_append(clients, entity->key) == 0;
+}
+
+static bool mapGridVisitAppendId(MapGridEntity *entity, void *ids) {
+    return neighborSetAppend(ids, entity->id);
+}
+
+static bool mapGridCellAdd(MapGridCell *cell, MapGridEntity *entity) {
+
+    if (cell->count == cell->capacity) {
+        size_t capacity = cell->capacity ? cell->capacity * 2 : MAP_GRID_CELL_DEFAULT_CAPACITY;
+        MapGridEntity **entities;
+
+        if (!(entities = realloc(cell->entities, capacity * sizeof(*entities)))) {
+            error("Cannot grow the cell.");
+            return false;
+        }
+
+        cell->entities = entities;
+        cell->capacity = capacity;
+    }
+
+    entity->slot = cell->count;
+    cell->entities[cell->count++] = entity;
+
+    return true;
+}
+
+static void mapGridCellRemove(MapGridCell *cell, MapGridEntity *entity) {
+
+    // Swap with the last entity of the cell
+    MapGridEntity *last = cell->entities[--cell->count];
+    cell->entities[entity->slot] = last;
+    last->slot = entity->slot;
+}
@@ -0,0 +1,106 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file map_grid.h
+ * @brief Uniform grid spatial hash of the clients of a map.
+ *
+ * The map plane is divided in square cells. Each client belongs to the cell containing its position,
+ * so a range query only scans the k×k cells covering the area : 3×3 cells when the range doesn't exceed
+ * the cell size. The grid is owned by a single thread, and isn't thread-safe.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+#include "R1EMU.h"
+#include "common/utils/position.h"
+#include "common/server/neighbor_set.h"
+
+/** Initial number of cells slots of a grid. Must be a power of 2. */
+#define MAP_GRID_CELLS_DEFAULT_CAPACITY 64
+
+/** Initial number of entities slots of a cell */
+#define MAP_GRID_CELL_DEFAULT_CAPACITY 8
+
+// MapGrid is an opaque structure
+typedef struct MapGrid MapGrid;
+
+/**
+ * @brief Allocate a new MapGrid structure.
+ * @param cellSize The width of a cell. Should be the usual range of the queries.
+ * @return A pointer to an allocated MapGrid, or NULL if an error occurred.
+ */
+MapGrid *mapGridNew(float cellSize);
+
+/**
+ * @brief Initialize an allocated MapGrid structure.
+ * @param self An allocated MapGrid to initialize.
+ * @param cellSize The width of a cell. Should be the usual range of the queries.
+ * @return true on success, false otherwise.
+ */
+bool mapGridInit(MapGrid *self, float cellSize);
+
+/**
+ * @brief Add a client to the grid, or move it if it is already in the grid
+ * @param self An allocated MapGrid
+ * @param key The socket ID of the client
+ * @param id The compact ID of the client
+ * @param position The new position of the client
+ * @return true on success, false otherwise
+ */
+bool mapGridUpdate(MapGrid *self, uint8_t *key, ClientId_t id, PositionXZ *position);
+
+/**
+ * @brief Remove a client from the grid
+ * @param self An allocated MapGrid
+ * @param key The socket ID of the client
+ * @return true if the client has been removed, false if it wasn't in the grid
+ */
+bool mapGridRemove(MapGrid *self, uint8_t *key);
+
+/**
+ * @brief Return the clients into the square area around a given position
+ * @param self An allocated MapGrid
+ * @param center The 2D position of the center of the area
+ * @param range Half width of the area
+ * @param ignoredKey if not NULL, don't include this socketId to the result
+ * @return a zlist_t of identity keys, owned by the list
+ */
+zlist_t *mapGridGetWithinRange(MapGrid *self, PositionXZ *center, float range, uint8_t *ignoredKey);
+
+/**
+ * @brief Return the IDs of the clients into the square area around a given position
+ * @param self An allocated MapGrid
+ * @param center The 2D position of the center of the area
+ * @param range Half width of the area
+ * @param ignoredKey if not NULL, don't include the ID of this socketId to the result
+ * @param[out] ids The sorted IDs of the clients
+ * @return true on success, false otherwise
+ */
+bool mapGridGetIdsWithinRange(MapGrid *self, PositionXZ *center, float range, uint8_t *ignoredKey, NeighborSet *ids);
+
+/**
+ * @brief Return the number of clients in the grid
+ * @param self An allocated MapGrid
+ */
+size_t mapGridSize(MapGrid *self);
+
+/**
+ * @brief Free an allocated MapGrid structure.
+ * @param self A pointer to an allocated MapGrid.
+ */
+void mapGridFree(MapGrid *self);
+
+/**
+ * @brief Free an allocated MapGrid structure and nullify the content of the pointer.
+ * @param self A pointer to an allocated MapGrid.
+ */
+void mapGridDestroy(MapGrid **self);
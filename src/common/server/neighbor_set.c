@@ -0,0 +1,196 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "neighbor_set.h"
+
+
+// ------ Static declaration -------
+/**
+ * @brief Make sure that a set can contain at least the given number of IDs
+ * @return true on success, false otherwise
+ */
+static bool neighborSetReserve(NeighborSet *self, size_t count);
+
+/**
+ * @brief Compare two ClientId_t for qsort
+ */
+static int neighborSetCompare(const void *a, const void *b);
+
+/**
+ * @brief Return the index of the first ID greater or equal to the given ID
+ */
+static size_t neighborSetLowerBound(NeighborSet *self, ClientId_t id);
+
+
+// ------ Extern function implementation -------
+
+void neighborSetInit(NeighborSet *self) {
+    self->ids = NULL;
+    self->count = 0;
+    self->capacity = 0;
+}
+
+void neighborSetClear(NeighborSet *self) {
+    self->count = 0;
+}
+
+bool neighborSetAppend(NeighborSet *self, ClientId_t id) {
+
+    if (!(neighborSetReserve(self, self->count + 1))) {
+        return false;
+    }
+
+    self->ids[self->count++] = id;
+
+    return true;
+}
+
+void neighborSetSort(NeighborSet *self) {
+    if (self->count > 1) {
+        qsort(self->ids, self->count, sizeof(ClientId_t), neighborSetCompare);
+    }
+}
+
+bool neighborSetInsert(NeighborSet *self, ClientId_t id) {
+
+    size_t index = neighborSetLowerBound(self, id);
+
+    if (index < self->count && self->ids[index] == id) {
+        // Already in the set
+        return true;
+    }
+
+    if (!(neighborSetReserve(self, self->count + 1))) {
+        return false;
+    }
+
+    memmove(&self->ids[index + 1], &self->ids[index], (self->count - index) * sizeof(ClientId_t));
+    self->ids[index] = id;
+    self->count++;
+
+    return true;
+}
+
+bool neighborSetRemove(NeighborSet *self, ClientId_t id) {
+
+    size_t index = neighborSetLowerBound(self, id);
+
+    if (index >= self->count || self->ids[index] != id) {
+        return false;
+    }
+
+    memmove(&self->ids[index], &self->ids[index + 1], (self->count - index - 1) * sizeof(ClientId_t));
+    self->count--;
+
+    return true;
+}
+
+bool neighborSetDiff(NeighborSet *before, NeighborSet *after, NeighborSet *entered, NeighborSet *left) {
+
+    size_t i = 0, j = 0;
+
+    neighborSetClear(entered);
+    neighborSetClear(left);
+
+    // Both sets are sorted : walk them together
+    while (i < before->count && j < after->count) {
+        if (before->ids[i] == after->ids[j]) {
+            i++;
+            j++;
+        }
+        else if (before->ids[i] < after->ids[j]) {
+            if (!(neighborSetAppend(left, before->ids[i++]))) {
+                return false;
+            }
+        }
+        else {
+            if (!(neighborSetAppend(entered, after->ids[j++]))) {
+                return false;
+            }
+        }
+    }
+
+    for (; i < before->count; i++) {
+        if (!(neighborSetAppend(left, before->ids[i]))) {
+            return false;
+        }
+    }
+
+    for (; j < after->count; j++) {
+        if (!(neighborSetAppend(entered, after->ids[j]))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void neighborSetSwap(NeighborSet *self, NeighborSet *other) {
+    NeighborSet tmp = *self;
+    *self = *other;
+    *other = tmp;
+}
+
+void neighborSetFree(NeighborSet *self) {
+    free(self->ids);
+    neighborSetInit(self);
+}
+
+
+// ------ Static function implementation -------
+
+static bool neighborSetReserve(NeighborSet *self, size_t count) {
+
+    if (count <= self->capacity) {
+        return true;
+    }
+
+    size_t capacity = self->capacity ? self->capacity : NEIGHBOR_SET_DEFAULT_CAPACITY;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    ClientId_t *ids;
+    if (!(ids = realloc(self->ids, capacity * sizeof(ClientId_t)))) {
+        error("Cannot grow the neighbor set.");
+        return false;
+    }
+
+    self->ids = ids;
+    self->capacity = capacity;
+
+    return true;
+}
+
+static int neighborSetCompare(const void *a, const void *b) {
+    ClientId_t id1 = *(const ClientId_t *) a;
+    ClientId_t id2 = *(const ClientId_t *) b;
+    return (id1 > id2) - (id1 < id2);
+}
+
+static size_t neighborSetLowerBound(NeighborSet *self, ClientId_t id) {
+
+    size_t low = 0, high = self->count;
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (self->ids[middle] < id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
@@ -0,0 +1,103 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file neighbor_set.h
+ * @brief Sorted array of compact client IDs.
+ *
+ * The visible set of a client is stored as a sorted array of the IDs of its neighbors,
+ * so the clients entering and leaving its view are computed with one linear merge.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+#include "R1EMU.h"
+
+/** Initial capacity of a NeighborSet */
+#define NEIGHBOR_SET_DEFAULT_CAPACITY 16
+
+/** Compact ID of a client in the EventServer */
+typedef uint32_t ClientId_t;
+
+/** A client without compact ID */
+#define CLIENT_ID_NONE ((ClientId_t) -1)
+
+/**
+ * @brief NeighborSet is a growable array of ClientId_t
+ */
+typedef struct NeighborSet {
+    ClientId_t *ids;
+    size_t count;
+    size_t capacity;
+} NeighborSet;
+
+/**
+ * @brief Initialize an empty NeighborSet
+ * @param self An allocated NeighborSet to initialize.
+ */
+void neighborSetInit(NeighborSet *self);
+
+/**
+ * @brief Remove all the IDs of a NeighborSet, without releasing its memory
+ * @param self An initialized NeighborSet
+ */
+void neighborSetClear(NeighborSet *self);
+
+/**
+ * @brief Append an ID at the end of the set. The set needs to be sorted afterward.
+ * @param self An initialized NeighborSet
+ * @param id The ID to append
+ * @return true on success, false otherwise
+ */
+bool neighborSetAppend(NeighborSet *self, ClientId_t id);
+
+/**
+ * @brief Sort the IDs of the set
+ * @param self An initialized NeighborSet
+ */
+void neighborSetSort(NeighborSet *self);
+
+/**
+ * @brief Insert an ID in a sorted set, if it isn't already in it
+ * @param self An initialized and sorted NeighborSet
+ * @param id The ID to insert
+ * @return true on success, false otherwise
+ */
+bool neighborSetInsert(NeighborSet *self, ClientId_t id);
+
+/**
+ * @brief Remove an ID from a sorted set
+ * @param self An initialized and sorted NeighborSet
+ * @param id The ID to remove
+ * @return true if the ID has been removed, false if it wasn't in the set
+ */
+bool neighborSetRemove(NeighborSet *self, ClientId_t id);
+
+/**
+ * @brief Compute the differences between two sorted sets, with a single linear merge
+ * @param before The previous set
+ * @param after The current set
+ * @param[out] entered The IDs of after that aren't in before
+ * @param[out] left The IDs of before that aren't in after
+ * @return true on success, false otherwise
+ */
+bool neighborSetDiff(NeighborSet *before, NeighborSet *after, NeighborSet *entered, NeighborSet *left);
+
+/**
+ * @brief Exchange the content of two sets
+ */
+void neighborSetSwap(NeighborSet *self, NeighborSet *other);
+
+/**
+ * @brief Release the memory of a NeighborSet
+ * @param self An initialized NeighborSet
+ */
+void neighborSetFree(NeighborSet *self);
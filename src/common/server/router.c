@@ -233,7 +233,7 @@ bool routerInfoInit(
     self->workersCount = workersCount;
     self->disconnectHandler = disconnectHandler;
 
-    if (!(redisInfoInit(&self->redisInfo, redisInfo->hostname, redisInfo->port))) {
+    if (!(redisInfoInit(&self->redisInfo, redisInfo->hostname, redisInfo->port, redisInfo->poolSize))) {
         error("Cannot initialize Redis Start up info.");
         return false;
     }
@@ -249,41 +249,80 @@ bool routerInfoInit(
 
 static int routerSubscribe(zloop_t *loop, zsock_t *publisher, void *_self) {
 
-    zmsg_t *msg;
-    zframe_t *header;
     Router *self = (Router *) _self;
-
-    // Receive the message from the publisher socket
-    if (!(msg = zmsg_recv(publisher))) {
+    void *input = zsock_resolve(publisher);
+    void *output = zsock_resolve(self->frontend);
+    RouterHeader packetHeader;
+    zmq_msg_t header, packet, identity, packetShare;
+    int more;
+
+    // Receive the header frame from the publisher socket
+    zmq_msg_init(&header);
+    if (zmq_msg_recv(&header, input, 0) == -1) {
         // Interrupt
+        zmq_msg_close(&header);
         return 0;
     }
 
-    // Get the header frame of the message
-    if (!(header = zmsg_pop (msg))) {
+    if (zmq_msg_size(&header) != sizeof(packetHeader)) {
         error("Frame header cannot be retrieved.");
+        zmq_msg_close(&header);
         return -1;
     }
 
     // Convert the header frame to a RouterHeader
-    RouterHeader packetHeader = *((RouterHeader *) zframe_data(header));
-    zframe_destroy(&header);
+    memcpy(&packetHeader, zmq_msg_data(&header), sizeof(packetHeader));
+    more = zmq_msg_more(&header);
+    zmq_msg_close(&header);
 
     switch (packetHeader)
     {
         case ROUTER_WORKER_MULTICAST: {
             // The worker send a 'multicast' message : It is addressed to a group of destination clients.
             // [1 frame data] + [1 frame identity] + [1 frame identity] + ...
-            zframe_t *dataFrame = zmsg_pop (msg);
-            size_t identityCount = zmsg_size(msg);
-            for (size_t count = 0; count < identityCount; count++) {
-                // TODO : Don't allocate a new zmsg_t for every submessage ?
-                zmsg_t *subMsg = zmsg_new();
-                zmsg_add(subMsg, zmsg_pop (msg));
-                zmsg_add(subMsg, zframe_dup (dataFrame));
-                zmsg_send(&subMsg, self->frontend);
+            if (!more) {
+                error("The multicast message doesn't contain any data.");
+                break;
+            }
+
+            zmq_msg_init(&packet);
+            if (zmq_msg_recv(&packet, input, 0) == -1) {
+                error("Cannot receive the multicast data.");
+                zmq_msg_close(&packet);
+                return -1;
+            }
+            more = zmq_msg_more(&packet);
+
+            while (more) {
+                zmq_msg_init(&identity);
+                if (zmq_msg_recv(&identity, input, 0) == -1) {
+                    error("Cannot receive the multicast identity.");
+                    zmq_msg_close(&identity);
+                    zmq_msg_close(&packet);
+                    return -1;
+                }
+                more = zmq_msg_more(&identity);
+
+                if (zmq_msg_size(&identity) == 0) {
+                    // Closing frame of a multicast aborted by the worker
+                    zmq_msg_close(&identity);
+                    continue;
+                }
+
+                // Each submessage shares the data with the others : ZMQ only counts its references
+                zmq_msg_init(&packetShare);
+                zmq_msg_copy(&packetShare, &packet);
+
+                if (zmq_msg_send(&identity, output, ZMQ_SNDMORE) == -1
+                ||  zmq_msg_send(&packetShare, output, 0) == -1) {
+                    warning("Cannot send the multicast data to a client.");
+                }
+                zmq_msg_close(&identity);
+                zmq_msg_close(&packetShare);
             }
-            zframe_destroy(&dataFrame);
+
+            zmq_msg_close(&packet);
+            more = false;
         } break;
 
         default:
@@ -291,8 +330,16 @@ static int routerSubscribe(zloop_t *loop, zsock_t *publisher, void *_self) {
         break;
     }
 
-    // Cleanup
-    zmsg_destroy(&msg);
+    // Drop the remaining frames of the message
+    while (more) {
+        zmq_msg_init(&identity);
+        if (zmq_msg_recv(&identity, input, 0) == -1) {
+            more = false;
+        } else {
+            more = zmq_msg_more(&identity);
+        }
+        zmq_msg_close(&identity);
+    }
 
     return 0;
 }
@@ -614,10 +661,13 @@ routerInitEventServerSubscriber(Router *self) {
     // ===================================
     //       Initialize subscriber
     // ===================================
-    if (zsock_connect (self->eventServer, ROUTER_SUBSCRIBER_ENDPOINT, self->info.routerId) != 0) {
-        error("Failed to connect to the eventServer subscriber endpoint %s.",
-            zsys_sprintf(ROUTER_SUBSCRIBER_ENDPOINT, self->info.routerId));
-        return false;
+    // Each EventServer shard publishes its own packets
+    for (uint16_t shardId = 0; shardId < eventServerGetShardsCount(); shardId++) {
+        if (zsock_connect (self->eventServer, ROUTER_SUBSCRIBER_ENDPOINT, self->info.routerId, shardId) != 0) {
+            error("Failed to connect to the eventServer subscriber endpoint %s.",
+                zsys_sprintf(ROUTER_SUBSCRIBER_ENDPOINT, self->info.routerId, shardId));
+            return false;
+        }
     }
 
     // Subscribe for all messages
@@ -160,7 +160,7 @@ bool routerMonitorInfoInit (
     self->routerId = routerId;
     self->disconnectHandler = disconnectHandler;
 
-    if (!(redisInfoInit(&self->redisInfo, redisInfo->hostname, redisInfo->port))) {
+    if (!(redisInfoInit(&self->redisInfo, redisInfo->hostname, redisInfo->port, redisInfo->poolSize))) {
         error("Cannot initialize Redis Start up info.");
         return false;
     }
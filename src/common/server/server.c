@@ -155,13 +155,15 @@ serverCreateProcess (
     );
 
     char *lastCommandLine;
-    lastCommandLine = zsys_sprintf("%s %d %s %d %s %s %s %s %s %d %d %s",
+    lastCommandLine = zsys_sprintf("%s %d %s %d %s %s %s %s %s %d %d %f %f %d %d %s",
         commandLine,
         self->routerInfo.workersCount,
         globalServerIp,
         globalServerPort,
         sqlInfo->hostname, sqlInfo->user, sqlInfo->password, sqlInfo->database,
-        redisInfo->hostname, redisInfo->port,
+        redisInfo->hostname, redisInfo->port, redisInfo->poolSize,
+        self->lodNearRange, self->lodMidRange,
+        self->eventServersCount,
         self->serverType,
         self->output
     );
@@ -33,6 +33,13 @@ typedef struct {
     int workersInfoCount;
     char *output;
     ServerType serverType;
+
+    // LOD bands of the EventServer
+    float lodNearRange;
+    float lodMidRange;
+
+    // Number of EventServer shards
+    uint16_t eventServersCount;
 } ServerInfo;
 
 /**
@@ -31,6 +31,7 @@ Server *serverFactoryCreateServer (
     char *sqlDatabase,
     char *redisHostname,
     int redisPort,
+    int redisPoolSize,
     DisconnectEventHandler disconnectHandler)
 {
     Server *server;
@@ -44,7 +45,7 @@ Server *serverFactoryCreateServer (
         output,
         globalServerIp, globalServerPort,
         sqlHostname, sqlUsername, sqlPassword, sqlDatabase,
-        redisHostname, redisPort, disconnectHandler
+        redisHostname, redisPort, redisPoolSize, disconnectHandler
     ))) {
         error("Cannot build a ServerInfo.");
         return NULL;
@@ -76,6 +77,7 @@ serverFactoryInitServerInfo (
     char *sqlDatabase,
     char *redisHostname,
     int redisPort,
+    int redisPoolSize,
     DisconnectEventHandler disconnectHandler
 ) {
     // Initialize MySQL start up information
@@ -87,7 +89,7 @@ serverFactoryInitServerInfo (
 
     // Initialize Redis start up information
     RedisInfo redisInfo;
-    if (!(redisInfoInit(&redisInfo, redisHostname, redisPort))) {
+    if (!(redisInfoInit(&redisInfo, redisHostname, redisPort, redisPoolSize))) {
         error("Cannot initialize correctly the Redis start up information.");
         return false;
     }
@@ -153,5 +155,12 @@ serverFactoryInitServerInfo (
         return false;
     }
 
+    // Default LOD bands, overridden by the zone servers configuration
+    serverInfo->lodNearRange = EVENT_SERVER_LOD_NEAR_RANGE_DEFAULT;
+    serverInfo->lodMidRange = EVENT_SERVER_LOD_MID_RANGE_DEFAULT;
+
+    // A single EventServer, the zone servers configuration can shard their maps
+    serverInfo->eventServersCount = 1;
+
     return true;
 }
@@ -37,6 +37,7 @@ Server *serverFactoryCreateServer(
     char *sqlDatabase,
     char *redisHostname,
     int redisPort,
+    int redisPoolSize,
     DisconnectEventHandler disconnectHandler);
 
 /**
@@ -58,4 +59,5 @@ bool serverFactoryInitServerInfo(
     char *sqlDatabase,
     char *redisHostname,
     int redisPort,
+    int redisPoolSize,
     DisconnectEventHandler disconnectHandler);
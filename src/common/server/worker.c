@@ -25,6 +25,7 @@
 #include "common/redis/fields/redis_game_session.h"
 #include "common/crypto/crypto.h"
 #include "common/packet/packet.h"
+#include "common/packet/packet_stream.h"
 #include "common/server/game_event.h"
 
 // Extend debug messages
@@ -124,6 +125,7 @@ workerHandlePacket (
  * @param[out] reply The message for the reply. Each frame contains a reply to send in different packets.
  * @param[in] headerAnswer The header of the answer message
  * @param[in] isCrypted Tells if the packet was crypted
+ * @param[in,out] sessionUpdated Set when the session has to be written back, cleared when it is deleted
  * @return true on success, false otherwise
  */
 static bool
@@ -134,7 +136,20 @@ workerProcessOneRequest (
     size_t packetSize,
     zmsg_t *msg,
     zframe_t *headerAnswer,
-    bool isCrypted
+    bool isCrypted,
+    bool *sessionUpdated
+);
+
+/**
+ * @brief Write back a session modified by the packets of a request
+ * @param self A pointer to the current worker
+ * @param[in] session The session of the client
+ * @return true on success, false otherwise
+ */
+static bool
+workerUpdateSession (
+    Worker *self,
+    Session *session
 );
 
 /**
@@ -231,6 +246,11 @@ bool workerInit (Worker *self, WorkerInfo *workerInfo) {
         return false;
     }
 
+    if (!(self->replyWriter = replyWriterNew(REPLY_WRITER_DEFAULT_CAPACITY))) {
+        error("Cannot allocate the reply writer.");
+        return false;
+    }
+
     // Initialize random seed
     self->seed = r1emuSeedRandom (self->info.routerId);
 
@@ -263,7 +283,7 @@ bool workerInfoInit (
 
     self->globalServerPort = globalServerPort;
 
-    if (!(redisInfoInit(&self->redisInfo, redisInfo->hostname, redisInfo->port))) {
+    if (!(redisInfoInit(&self->redisInfo, redisInfo->hostname, redisInfo->port, redisInfo->poolSize))) {
         error("Cannot initialize Redis Start up info.");
         return false;
     }
@@ -390,6 +410,9 @@ workerBuildReply(
     size_t packetSizeRemaining = packetSize;
     int isCrypted;
 
+    // All the packets of the request share the session : it is written back once, after the last one
+    bool sessionUpdated = false;
+
     // Get the session
     DbObject *sessionObject = NULL;
     Session *session = NULL;
@@ -414,7 +437,7 @@ workerBuildReply(
         }
 
         // Process the request
-        if ((!(workerProcessOneRequest(self, session, &packet[packetPos], subPacketSize, msg, headerAnswer, isCrypted)))) {
+        if ((!(workerProcessOneRequest(self, session, &packet[packetPos], subPacketSize, msg, headerAnswer, isCrypted, &sessionUpdated)))) {
             error("Cannot process properly a reply.");
             goto cleanup;
         }
@@ -427,6 +450,11 @@ workerBuildReply(
     status = true;
 
 cleanup:
+    // The packets processed before an error keep their modifications
+    if (sessionUpdated && !(workerUpdateSession(self, session))) {
+        error("Cannot update the session.");
+        status = false;
+    }
     // dbObjectDestroy(&sessionObject);
     return status;
 }
@@ -439,7 +467,8 @@ workerProcessOneRequest(
     size_t packetSize,
     zmsg_t *msg,
     zframe_t *headerAnswer,
-    bool isCrypted
+    bool isCrypted,
+    bool *sessionUpdated
 ) {
     bool status = false;
 
@@ -475,25 +504,15 @@ workerProcessOneRequest(
         case PACKET_HANDLER_OK:
         break;
 
-        case PACKET_HANDLER_UPDATE_SESSION: {
-            DbObject object;
-            if (!(dbObjectInit(&object, sizeof(*session), session, true))) {
-                error("Cannot initialize dbObject.");
-                goto cleanup;
-            }
-
-            if (!(dbClientUpdateObject(self->dbSession, session->socket.sessionKey, &object))) {
-                error("Cannot update the memory session.");
-                goto cleanup;
-            }
-
-            if (!(redisUpdateSession(self->redis, session))) {
-                error("Cannot update the Redis session.");
-                goto cleanup;
-            }
-        }   break;
+        case PACKET_HANDLER_UPDATE_SESSION:
+            // Written back by workerBuildReply once all the packets are processed
+            *sessionUpdated = true;
+        break;
 
         case PACKET_HANDLER_DELETE_SESSION: {
+            // The deletion overrides the updates of the previous packets
+            *sessionUpdated = false;
+
             RedisSessionKey sessionKey = {
                 .socketKey = {
                     .routerId = session->socket.routerId,
@@ -514,6 +533,31 @@ cleanup:
     return status;
 }
 
+static bool
+workerUpdateSession(
+    Worker *self,
+    Session *session
+) {
+    DbObject object;
+
+    if (!(dbObjectInit(&object, sizeof(*session), session, true))) {
+        error("Cannot initialize dbObject.");
+        return false;
+    }
+
+    if (!(dbClientUpdateObject(self->dbSession, session->socket.sessionKey, &object))) {
+        error("Cannot update the memory session.");
+        return false;
+    }
+
+    if (!(redisUpdateSession(self->redis, session))) {
+        error("Cannot update the Redis session.");
+        return false;
+    }
+
+    return true;
+}
+
 static PacketHandlerState
 workerHandlePacket(
     Worker *self,
@@ -540,15 +584,12 @@ workerHandlePacket(
 
     // Test if a handler is associated with the packet type requested.
     if (!(handler = packetHandlers [header.type].handler)) {
-        error("Cannot find handler for the requested packet type : %s",
-            (header.type < PACKET_TYPES_MAX_INDEX) ?
-               packetTypeInfo.packets[header.type].name : "UNKNOWN"
-        );
+        error("Cannot find handler for the requested packet type : %s", packetTypeToString(header.type));
         goto cleanup;
     }
 
     // Call the handler
-    special("Calling [%s] handler", packetTypeInfo.packets[header.type].name);
+    special("Calling [%s] handler", packetTypeToString(header.type));
     status = handler(self, session, packet, packetSize, reply);
 
 cleanup:
@@ -688,6 +729,8 @@ cleanup:
     zloop_destroy (&reactor);
     zsock_destroy (&worker);
     zsock_destroy (&global);
+    zlibFree ();
+    packetStreamPoolFree ();
 
     workerInfo(self, "stopped running.");
     return NULL;
@@ -776,6 +819,9 @@ static int workerHandlePublicRequest(zloop_t *loop, zsock_t *worker, void *_self
         goto cleanup;
     }
 
+    // The packets built for the client are written in the buffer of the worker
+    replyWriterBegin(self->replyWriter, msg);
+
     if (!(workerProcessClientPacket(self, msg))) {
         workerError(self, "Cannot handle correctly the client packet.");
         result = 0;
@@ -783,7 +829,7 @@ static int workerHandlePublicRequest(zloop_t *loop, zsock_t *worker, void *_self
     }
 
     // Reply back to the sender
-    if (zmsg_send(&msg, worker) != 0) {
+    if (!(replyWriterSend(self->replyWriter, &msg, worker))) {
         workerWarning(self, "Failed to send a message to the backend.");
         result = -1;
         goto cleanup;
@@ -795,9 +841,9 @@ cleanup:
     return result;
 }
 
-bool workerDispatchEvent (Worker *self, uint8_t *emitterSk, EventType eventType, void *event, size_t eventSize)
+bool workerDispatchEvent (Worker *self, MapId_t mapId, uint8_t *emitterSk, EventType eventType, void *event, size_t eventSize)
 {
-    return eventServerDispatchEvent(self->eventServer, emitterSk, eventType, event, eventSize);
+    return eventServerDispatchEvent(self->eventServer, mapId, emitterSk, eventType, event, eventSize);
 }
 
 void workerInfoFree(WorkerInfo *self) {
@@ -807,6 +853,7 @@ void workerInfoFree(WorkerInfo *self) {
 }
 
 void workerFree(Worker *self) {
+    replyWriterDestroy(&self->replyWriter);
     redisDestroy(&self->redis);
     mySqlDestroy(&self->sqlConn);
 }
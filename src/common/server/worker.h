@@ -30,6 +30,7 @@
 #include "common/redis/redis.h"
 #include "common/session/session.h"
 #include "common/db/db_client.h"
+#include "common/packet/reply_writer.h"
 
 // Types definition
 typedef struct _PacketHandler PacketHandler;
@@ -115,6 +116,9 @@ struct _Worker {
 
     // the Redis session
     Redis *redis;
+
+    // the buffer of the packets replied to the client
+    ReplyWriter *replyWriter;
 };
 
 /**
@@ -198,12 +202,13 @@ void *workerMainLoop(void *arg);
 /**
  * @brief Send an event to the attached EventServer
  * @param self An allocated Worker
+ * @param mapId The map of the event emitter, selecting the EventServer shard
  * @param emitterSk The session key of the event emitter
  * @param eventType The type of the event
  * @param event The event data
  * @param eventSize The event size
  */
-bool workerDispatchEvent(Worker *self, uint8_t *emitterSk, EventType eventType, void *event, size_t eventSize);
+bool workerDispatchEvent(Worker *self, MapId_t mapId, uint8_t *emitterSk, EventType eventType, void *event, size_t eventSize);
 
 /**
  * @brief Free an allocated Worker structure.
@@ -80,7 +80,7 @@ socketSessionGenSessionKey (
 void
 socketSessionGenId (
     uint8_t *sessionKey,
-    uint8_t sessionId[5]
+    uint8_t sessionId[SOCKET_SESSION_IDENTITY_SIZE]
 ) {
     uint64_t identity = strtoull(sessionKey, NULL, 16);
     // Format the sessionId from the session key
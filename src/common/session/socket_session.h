@@ -22,6 +22,7 @@
 #define SOCKET_SESSION_UNDEFINED_ACCOUNT -1
 
 #define SOCKET_SESSION_ID_SIZE 11
+#define SOCKET_SESSION_IDENTITY_SIZE 5
 
 /**
  * @brief SocketSession identifies a session socket to an account
@@ -85,7 +86,7 @@ void socketSessionGenSessionKey(uint8_t *sessionId, uint8_t sessionKey[SOCKET_SE
  * @param[out] sessionId The sessionId generated
  * @return
  */
-void socketSessionGenId(uint8_t *sessionKey, uint8_t sessionId[5]);
+void socketSessionGenId(uint8_t *sessionKey, uint8_t sessionId[SOCKET_SESSION_IDENTITY_SIZE]);
 
 /**
  * @brief Prints a SocketSession structure.
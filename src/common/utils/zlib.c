@@ -19,6 +19,19 @@
 // ------ Structure declaration -------
 
 // ------ Static declaration -------
+/** Compression context of the current thread, allocated by its first compression and reset afterward */
+static __thread z_stream zlibDeflateStream;
+static __thread bool zlibDeflateStreamReady = false;
+
+/**
+ * @brief : Get the compression context of the current thread, ready for new data
+ */
+static z_stream *zlibGetDeflateStream(void);
+
+/**
+ * @brief : Compress the data of the chunk
+ */
+static bool zlibStreamFlush(ZlibStream *self, int flush);
 
 
 // ------ Extern function implementation -------
@@ -28,35 +41,25 @@ zlibCompress (
     void *data,
     size_t dataSize
 ) {
-    z_stream stream;
-
-    stream.next_in = data;
-    stream.avail_in = dataSize;
-    stream.avail_out = sizeof(self->buffer);
-    stream.next_out = self->buffer;
-    stream.total_in = 0;
-    stream.total_out = 0;
-    stream.zalloc = 0;
-    stream.zfree = 0;
-
+    z_stream *stream;
     int result;
-    if ((result = deflateInit2 (&stream, 1, Z_DEFLATED, -15, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY)) != Z_OK) {
-        warning("Can't init compression : error code = %x.", result);
-        return false;
-    }
 
-    if ((result = deflate (&stream, Z_FINISH) != Z_STREAM_END)) {
-        warning("Can't compress : error code = %x.", result);
+    if (!(stream = zlibGetDeflateStream ())) {
         return false;
     }
 
-    if ((result = deflateEnd (&stream) != Z_OK)) {
-        warning("Can't end compression : error code = %x", result);
+    stream->next_in = data;
+    stream->avail_in = dataSize;
+    stream->avail_out = sizeof(self->buffer);
+    stream->next_out = self->buffer;
+
+    if ((result = deflate (stream, Z_FINISH)) != Z_STREAM_END) {
+        warning("Can't compress : error code = %x.", result);
         return false;
     }
 
     self->header.magic = ZLIB_MAGIC_HEADER;
-    self->header.size = stream.total_out;
+    self->header.size = stream->total_out;
 
     return true;
 }
@@ -101,3 +104,168 @@ zlibDecompress (
 
     return true;
 }
+
+size_t
+zlibCompressBound (
+    size_t dataSize
+) {
+    z_stream *stream;
+
+    if (!(stream = zlibGetDeflateStream ())) {
+        // Worst case of deflate, for any parameter
+        return dataSize + ((dataSize + 7) >> 3) + ((dataSize + 63) >> 6) + 5;
+    }
+
+    return deflateBound (stream, dataSize);
+}
+
+bool
+zlibStreamInit (
+    ZlibStream *self,
+    Zlib *output,
+    size_t outputCapacity
+) {
+    z_stream *stream;
+
+    if (!(stream = zlibGetDeflateStream ())) {
+        return false;
+    }
+
+    self->output = output;
+    self->outputCapacity = outputCapacity;
+    self->chunkSize = 0;
+
+    stream->next_out = output->buffer;
+    stream->avail_out = outputCapacity;
+
+    return true;
+}
+
+void *
+zlibStreamReserve (
+    ZlibStream *self,
+    size_t size
+) {
+    void *data;
+
+    if (size > sizeof(self->chunk)) {
+        return NULL;
+    }
+
+    // Compress the chunk if the data doesn't fit anymore
+    if (self->chunkSize + size > sizeof(self->chunk)) {
+        if (!(zlibStreamFlush (self, Z_NO_FLUSH))) {
+            return NULL;
+        }
+    }
+
+    data = &self->chunk[self->chunkSize];
+    self->chunkSize += size;
+    memset(data, 0, size);
+
+    return data;
+}
+
+bool
+zlibStreamWrite (
+    ZlibStream *self,
+    const void *data,
+    size_t size
+) {
+    const uint8_t *input = data;
+
+    while (size > 0) {
+        size_t copySize = sizeof(self->chunk) - self->chunkSize;
+        if (copySize > size) {
+            copySize = size;
+        }
+
+        memcpy(&self->chunk[self->chunkSize], input, copySize);
+        self->chunkSize += copySize;
+        input += copySize;
+        size -= copySize;
+
+        if (self->chunkSize == sizeof(self->chunk)) {
+            if (!(zlibStreamFlush (self, Z_NO_FLUSH))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool
+zlibStreamFinish (
+    ZlibStream *self
+) {
+    if (!(zlibStreamFlush (self, Z_FINISH))) {
+        return false;
+    }
+
+    self->output->header.magic = ZLIB_MAGIC_HEADER;
+    self->output->header.size = zlibDeflateStream.total_out;
+
+    return true;
+}
+
+void
+zlibFree (
+    void
+) {
+    if (zlibDeflateStreamReady) {
+        deflateEnd (&zlibDeflateStream);
+        zlibDeflateStreamReady = false;
+    }
+}
+
+// ------ Static function implementation -------
+
+static z_stream *
+zlibGetDeflateStream (
+    void
+) {
+    z_stream *stream = &zlibDeflateStream;
+    int result;
+
+    // Allocating the deflate state is much more expensive than compressing a packet : do it once per thread
+    if (!zlibDeflateStreamReady) {
+        memset(stream, 0, sizeof(*stream));
+        if ((result = deflateInit2 (stream, 1, Z_DEFLATED, -15, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY)) != Z_OK) {
+            warning("Can't init compression : error code = %x.", result);
+            return NULL;
+        }
+        zlibDeflateStreamReady = true;
+    }
+    else if ((result = deflateReset (stream)) != Z_OK) {
+        warning("Can't reset compression : error code = %x.", result);
+        return NULL;
+    }
+
+    return stream;
+}
+
+static bool
+zlibStreamFlush (
+    ZlibStream *self,
+    int flush
+) {
+    z_stream *stream = &zlibDeflateStream;
+    int result;
+
+    stream->next_in = self->chunk;
+    stream->avail_in = self->chunkSize;
+
+    result = deflate (stream, flush);
+
+    // The output has been sized with zlibCompressBound : all the chunk must have been consumed
+    if ((flush == Z_FINISH && result != Z_STREAM_END)
+    ||  (flush != Z_FINISH && result != Z_OK)
+    ||  stream->avail_in != 0) {
+        warning("Can't compress : error code = %x.", result);
+        return false;
+    }
+
+    self->chunkSize = 0;
+    return true;
+}
@@ -33,8 +33,25 @@ typedef struct {
     uint8_t buffer [0x40000];
 } Zlib;
 
+/** Size of the chunks given to deflate by a ZlibStream */
+#define ZLIB_STREAM_CHUNK_SIZE 4096
+
+/**
+ * @brief ZlibStream compresses data written piece by piece, in bounded chunks, into a Zlib of a given capacity.
+ *        It uses the compression context of the current thread : only one ZlibStream per thread at a time.
+ */
+typedef struct {
+    // the Zlib written, and the space available in its buffer
+    Zlib *output;
+    size_t outputCapacity;
+
+    // data waiting to be compressed
+    uint8_t chunk [ZLIB_STREAM_CHUNK_SIZE];
+    size_t chunkSize;
+} ZlibStream;
+
 /**
- * @brief : Compress a given data to a Zlib
+ * @brief : Compress a given data to a Zlib, with the compression context of the current thread
  */
 bool zlibCompress(Zlib *self, void *data, size_t dataSize);
 
@@ -42,3 +59,33 @@ bool zlibCompress(Zlib *self, void *data, size_t dataSize);
  * @brief : Decompress a given data to a Zlib
  */
 bool zlibDecompress(Zlib *self, void *data, size_t dataSize);
+
+/**
+ * @brief : Get the maximum size of the compressed data. Call it before zlibStreamInit, not during a compression
+ */
+size_t zlibCompressBound(size_t dataSize);
+
+/**
+ * @brief : Start compressing into a Zlib, with outputCapacity bytes available in its buffer
+ */
+bool zlibStreamInit(ZlibStream *self, Zlib *output, size_t outputCapacity);
+
+/**
+ * @brief : Get contiguous space for size bytes of data to compress, NULL if it is bigger than a chunk
+ */
+void *zlibStreamReserve(ZlibStream *self, size_t size);
+
+/**
+ * @brief : Copy data to compress
+ */
+bool zlibStreamWrite(ZlibStream *self, const void *data, size_t size);
+
+/**
+ * @brief : Compress the remaining data and complete the Zlib header
+ */
+bool zlibStreamFinish(ZlibStream *self);
+
+/**
+ * @brief : Free the compression context of the current thread
+ */
+void zlibFree(void);
@@ -19,6 +19,7 @@
 #include "social_server/social_server.h"
 #include "common/server/server_factory.h"
 #include "common/packet/packet_type.h"
+#include "common/redis/redis_pool.h"
 #include <jansson.h>
 
 /**
@@ -79,12 +80,6 @@ bool globalServerInit(GlobalServer *self, GlobalServerInfo *info) {
         error("Cannot connect to Redis.");
         return false;
     }
-
-    // Initialize packets manager
-    if (!(packetTypeInit())) {
-        error("Cannot initialize packet manager.");
-        return false;
-    }
 
     return true;
 }
@@ -144,6 +139,17 @@ bool globalServerReadBasicServerConf(BasicServerConf *basicConf, json_t *servers
         goto cleanup;
     }
     basicConf->output = strdup(json_string_value(field));
+
+    // read redis pool size (optional)
+    basicConf->redisPoolSize = REDIS_POOL_SIZE_DEFAULT;
+    if ((field = json_object_get(server, "redisPoolSize"))) {
+        if (!(json_is_string(field))) {
+            error("Cannot read 'redisPoolSize' field.");
+            result = false;
+            goto cleanup;
+        }
+        basicConf->redisPoolSize = atoi(json_string_value(field));
+    }
 
 cleanup:
     return result;
@@ -319,6 +325,38 @@ bool globalServerInfoInit(GlobalServerInfo *self, char *confFilePath) {
             result = false;
             goto cleanup;
         }
+
+        // read the LOD bands of the broadcasts (optional)
+        json_t *zoneServer = json_array_get(zoneServers, id);
+        curConf->lodNearRange = EVENT_SERVER_LOD_NEAR_RANGE_DEFAULT;
+        if ((field = json_object_get(zoneServer, "lodNearRange"))) {
+            if (!(json_is_string(field))) {
+                error("Cannot read 'lodNearRange' field.");
+                result = false;
+                goto cleanup;
+            }
+            curConf->lodNearRange = atof(json_string_value(field));
+        }
+        curConf->lodMidRange = EVENT_SERVER_LOD_MID_RANGE_DEFAULT;
+        if ((field = json_object_get(zoneServer, "lodMidRange"))) {
+            if (!(json_is_string(field))) {
+                error("Cannot read 'lodMidRange' field.");
+                result = false;
+                goto cleanup;
+            }
+            curConf->lodMidRange = atof(json_string_value(field));
+        }
+
+        // read the number of EventServer shards (optional)
+        curConf->eventServersCount = EVENT_SERVER_SHARDS_COUNT_DEFAULT;
+        if ((field = json_object_get(zoneServer, "eventServersCount"))) {
+            if (!(json_is_string(field))) {
+                error("Cannot read 'eventServersCount' field.");
+                result = false;
+                goto cleanup;
+            }
+            curConf->eventServersCount = atoi(json_string_value(field));
+        }
     }
 
     // ===================================
@@ -405,6 +443,9 @@ bool globalServerInfoInit(GlobalServerInfo *self, char *confFilePath) {
     }
     self->redisInfo.port = atoi(json_string_value(field));
 
+    // the global server only needs one connection
+    self->redisInfo.poolSize = 1;
+
 cleanup:
     // close the configuration file
     free(confStr);
@@ -494,7 +535,7 @@ bool globalServerStart(GlobalServer *self) {
             globalInfo->globalConf.ip, globalInfo->globalConf.port,
             globalInfo->sqlInfo.hostname, globalInfo->sqlInfo.user,
             globalInfo->sqlInfo.password, globalInfo->sqlInfo.database,
-            globalInfo->redisInfo.hostname, globalInfo->redisInfo.port,
+            globalInfo->redisInfo.hostname, globalInfo->redisInfo.port, basicConf->redisPoolSize,
             NULL)))
         {
             error("[Barrack] Cannot create a new ServerInfo.");
@@ -523,7 +564,7 @@ bool globalServerStart(GlobalServer *self) {
             globalInfo->globalConf.ip, globalInfo->globalConf.port,
             globalInfo->sqlInfo.hostname, globalInfo->sqlInfo.user,
             globalInfo->sqlInfo.password, globalInfo->sqlInfo.database,
-            globalInfo->redisInfo.hostname, globalInfo->redisInfo.port,
+            globalInfo->redisInfo.hostname, globalInfo->redisInfo.port, basicConf->redisPoolSize,
             NULL)))
         {
             error("[Social] Cannot create a new ServerInfo.");
@@ -552,12 +593,15 @@ bool globalServerStart(GlobalServer *self) {
             globalInfo->globalConf.ip, globalInfo->globalConf.port,
             globalInfo->sqlInfo.hostname, globalInfo->sqlInfo.user,
             globalInfo->sqlInfo.password, globalInfo->sqlInfo.database,
-            globalInfo->redisInfo.hostname, globalInfo->redisInfo.port,
+            globalInfo->redisInfo.hostname, globalInfo->redisInfo.port, basicConf->redisPoolSize,
             zoneEventServerOnDisconnect)))
         {
             error("[Zone] Cannot create a new ServerInfo.");
             return false;
         }
+        serverInfo.lodNearRange = curConf->lodNearRange;
+        serverInfo.lodMidRange = curConf->lodMidRange;
+        serverInfo.eventServersCount = curConf->eventServersCount;
 
         if (!(serverCreateProcess(&serverInfo, ZONE_SERVER_EXECUTABLE_NAME))) {
             error("[Zone] Can't launch a new Server process.");
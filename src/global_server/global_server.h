@@ -65,6 +65,7 @@ typedef struct {
     int port;
     int workersCount;
     char *output;
+    int redisPoolSize;
 }   BasicServerConf;
 
 typedef struct {
@@ -82,6 +83,9 @@ typedef struct {
 
 typedef struct {
     BasicServerConf basicConf;
+    float lodNearRange;
+    float lodMidRange;
+    uint16_t eventServersCount;
 }   ZoneServerConf;
 
 typedef struct {
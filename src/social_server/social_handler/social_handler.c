@@ -55,7 +55,7 @@ static PacketHandlerState socialHandlerLogin(
     } *clientPacket = (void *) packet;
     #pragma pack(pop)
 
-    CHECK_CLIENT_PACKET_SIZE(*clientPacket, packetSize, CS_LOGIN);
+    CHECK_CLIENT_PACKET_SIZE_WAIVED(*clientPacket, packetSize, CS_LOGIN);
 
     // Authenticate here
     // TODO
@@ -62,6 +62,10 @@ int main (int argc, char **argv)
     char *sqlDatabase = *++argv;
     char *redisHostname = *++argv;
     int redisPort = atoi(*++argv);
+    int redisPoolSize = atoi(*++argv);
+    float lodNearRange = atof(*++argv);
+    float lodMidRange = atof(*++argv);
+    uint16_t eventServersCount = atoi(*++argv);
     ServerType serverType = atoi(*++argv);
     char *output = *++argv;
 
@@ -89,20 +93,27 @@ int main (int argc, char **argv)
     }
     #endif
 
-    // === Build the Event Server ===
-    EventServer *eventServer;
-    EventServerInfo eventServerInfo;
-    if (!(eventServerInfoInit(&eventServerInfo, routerId, workersCount, redisHostname, redisPort))) {
-        error("Cannot initialize the event server.");
+    // === Build the Event Servers, one per shard of maps ===
+    if (!(eventServerSetShardsCount(eventServersCount))) {
+        error("Cannot set the number of event servers.");
         return -1;
     }
-    if (!(eventServer = eventServerNew(&eventServerInfo, serverType))) {
-        error("Cannot create the event server.");
-        return -1;
-    }
-    if ((zthread_new((zthread_detached_fn *) eventServerStart, eventServer)) != 0) {
-        error("Cannot start the event server.");
-        return -1;
+    for (uint16_t shardId = 0; shardId < eventServersCount; shardId++) {
+        EventServer *eventServer;
+        EventServerInfo eventServerInfo;
+        if (!(eventServerInfoInit(&eventServerInfo, routerId, shardId, workersCount, redisHostname, redisPort, redisPoolSize,
+                                 lodNearRange, lodMidRange))) {
+            error("Cannot initialize the event server.");
+            return -1;
+        }
+        if (!(eventServer = eventServerNew(&eventServerInfo, serverType))) {
+            error("Cannot create the event server.");
+            return -1;
+        }
+        if ((zthread_new((zthread_detached_fn *) eventServerStart, eventServer)) != 0) {
+            error("Cannot start the event server.");
+            return -1;
+        }
     }
 
     // Specific server stuff
@@ -136,7 +147,7 @@ int main (int argc, char **argv)
         output,
         globalServerIp, globalServerPort,
         sqlHostname, sqlUsername, sqlPassword, sqlDatabase,
-        redisHostname, redisPort, disconnectHandler
+        redisHostname, redisPort, redisPoolSize, disconnectHandler
     ))) {
         error("Cannot create a Server.");
         return -1;
@@ -40,6 +40,100 @@ bool zoneEventServerProcess(EventServer *self, EventType type, void *eventData)
     return handler(self, eventData);
 }
 
+ZoneClientAppearance *zoneEventServerSetClientAppearance (
+    EventServer *self,
+    uint8_t *sessionKey,
+    CommanderAppearance *appearance,
+    PositionXYZ *position
+) {
+    ZoneClientAppearance *clientAppearance = NULL;
+    zmsg_t *enterPcMsg = NULL;
+    size_t appearanceSize;
+
+    // Build the ZC_ENTER_PC once, it is sent as is to the clients who see the client entering
+    enterPcMsg = zmsg_new();
+    zoneBuilderEnterPc(appearance, position, enterPcMsg);
+    zframe_t *enterPcFrame = zmsg_first(enterPcMsg);
+
+    uint8_t buffer[sizeof(ZoneClientAppearance) + zframe_size(enterPcFrame)];
+    ZoneClientAppearance *newAppearance = (void *) buffer;
+    newAppearance->appearance = *appearance;
+    newAppearance->position = *position;
+    newAppearance->enterPcPacketSize = zframe_size(enterPcFrame);
+    memcpy(newAppearance->enterPcPacket, zframe_data(enterPcFrame), zframe_size(enterPcFrame));
+
+    if (!(eventServerSetClientAppearance(self, sessionKey, buffer, sizeof(buffer)))) {
+        error("Cannot keep the appearance of %s.", sessionKey);
+        goto cleanup;
+    }
+
+    clientAppearance = eventServerGetClientAppearance(self, sessionKey, &appearanceSize);
+
+cleanup:
+    zmsg_destroy(&enterPcMsg);
+    return clientAppearance;
+}
+
+/**
+ * @brief Load the appearance of a client from its game session, and keep it for the next events
+ */
+static ZoneClientAppearance *zoneEventServerLoadClientAppearance(
+    EventServer *self,
+    RouterId_t routerId,
+    uint8_t *sessionKey
+) {
+    ZoneClientAppearance *clientAppearance = NULL;
+    CommanderAppearance appearance;
+    GameSession gameSession;
+    Commander *commander;
+
+    // The game session owns the commander it loads, even when the loading fails
+    memset(&gameSession, 0, sizeof(gameSession));
+
+    // The client entered in the zone before this EventServer started to keep its appearance
+    if (!(eventServerGetGameSessionBySocketId(self, routerId, sessionKey, &gameSession))) {
+        error("Cannot get game session from %s.", sessionKey);
+        goto cleanup;
+    }
+
+    if (!(commander = gameSession.commanderSession.currentCommander)) {
+        error("The game session of %s doesn't have any commander.", sessionKey);
+        goto cleanup;
+    }
+
+    commanderAppearanceInit(&appearance, commander);
+    clientAppearance = zoneEventServerSetClientAppearance(self, sessionKey, &appearance, &commander->pos);
+
+cleanup:
+    commanderDestroy(&gameSession.commanderSession.currentCommander);
+    return clientAppearance;
+}
+
+ZoneClientAppearance *zoneEventServerGetClientAppearance(EventServer *self, uint8_t *sessionKey) {
+
+    ZoneClientAppearance *clientAppearance;
+    size_t appearanceSize;
+
+    if ((clientAppearance = eventServerGetClientAppearance(self, sessionKey, &appearanceSize))) {
+        return clientAppearance;
+    }
+
+    return zoneEventServerLoadClientAppearance(self, eventServerGetRouterId(self), sessionKey);
+}
+
+ZoneClientAppearance *zoneEventServerGetClientAppearanceById(EventServer *self, ClientId_t client) {
+
+    GraphNode *node = eventServerGetClientNodeById(self, client);
+    GraphNodeClient *nodeClient = node->user_data;
+
+    if (nodeClient->appearance) {
+        return nodeClient->appearance;
+    }
+
+    // The graph keys are the session keys of the clients
+    return zoneEventServerLoadClientAppearance(self, nodeClient->routerId, (uint8_t *) node->key);
+}
+
 bool zoneEventServerOnDisconnect (
     zsock_t *eventServer,
     Redis *redis,
@@ -47,18 +141,32 @@ bool zoneEventServerOnDisconnect (
     RouterId_t routerId,
     uint8_t *sessionKeyStr
 ) {
-    // Get the current game session
+    // Get the current game session and flush the Redis session of the client at once
     GameSession gameSession;
-    if (!(redisGetGameSessionBySocketId(redis, routerId, sessionKeyStr, &gameSession))) {
-        error("Cannot get game session of '%s'", sessionKeyStr);
+    bool found;
+    RedisSessionKey sessionKey = {
+        .socketKey = {
+            .routerId = routerId,
+            .sessionKey = sessionKeyStr
+        }
+    };
+
+    if (!(redisGetAndFlushSession(redis, &sessionKey, &gameSession, &found))) {
+        error("Cannot get and flush the game session of '%s'", sessionKeyStr);
         return false;
     }
 
+    if (!found || !gameSession.commanderSession.currentCommander) {
+        // The game session isn't in this zone anymore
+        return true;
+    }
+
     // Send a EVENT_TYPE_LEAVE packet to the event server
     GameEventLeave event = {
         .pcId = gameSession.commanderSession.currentCommander->pcId
     };
-    eventServerDispatchEvent(eventServer, sessionKeyStr, EVENT_TYPE_LEAVE, &event, sizeof(event));
+    eventServerDispatchEvent(eventServer, gameSession.commanderSession.currentCommander->mapId,
+        sessionKeyStr, EVENT_TYPE_LEAVE, &event, sizeof(event));
 
     // Transfer the Redis session to SQL
     if (!(mySqlCommanderSessionFlush(mysql, &gameSession.commanderSession))) {
@@ -67,198 +175,136 @@ bool zoneEventServerOnDisconnect (
         // TODO : Should we flush the Redis data in that case ?
     }
 
-    // Flush the Redis session of the client
-    RedisSessionKey sessionKey = {
-        .socketKey = {
-            .routerId = routerId,
-            .sessionKey = sessionKeyStr
-        }
-    };
-
-    if (!(redisFlushSession (redis, &sessionKey))) {
-        error ("Cannot flush the redis session '%s'", sessionKeyStr);
-        return false;
-    }
-
     return true;
 }
 
+bool zoneEventServerDispatchWarp (
+    zsock_t *eventServer,
+    uint8_t *sessionKeyStr,
+    PcId_t pcId,
+    MapId_t fromMapId,
+    MapId_t toMapId
+) {
+    if (eventServerGetMapShard(fromMapId) == eventServerGetMapShard(toMapId)) {
+        // The same shard switches the grid of the client at its next position update
+        return true;
+    }
+
+    GameEventWarp event = {
+        .pcId = pcId,
+        .toMapId = toMapId
+    };
+
+    return eventServerDispatchEvent(eventServer, fromMapId, sessionKeyStr, EVENT_TYPE_WARP, &event, sizeof(event));
+}
+
 bool zoneEventServerUpdateClientPosition(
     EventServer *self,
     GameEvent *event,
     GameEventUpdatePosition *updatePosEvent,
-    zlist_t **_redisClientsAround)
+    NeighborSet **_clientsAround)
 {
     bool status = true;
 
     zmsg_t *pcEnterMsg = NULL;
-    zmsg_t *curPcEnterMsg = NULL;
     zmsg_t *pcLeaveMsg = NULL;
-    zmsg_t *curPcLeaveMsg = NULL;
-    zlist_t *pcEnterList = NULL;
-    zlist_t *pcLeaveList = NULL;
-    zlist_t *redisClientsAround = NULL;
+    NeighborSet *pcEnterList = NULL;
+    NeighborSet *pcLeaveList = NULL;
+    NeighborSet *clientsAround = NULL;
 
     uint8_t *emitterSk = event->emitterSk;
     MapId_t mapId = updatePosEvent->mapId;
-    Commander *commander = &updatePosEvent->commander;
+    ZoneClientAppearance *clientAppearance;
+    ClientId_t emitterId;
 
-    // Get the clients around
-    if (!(redisClientsAround = eventServerRedisGetClientsWithinRange(
-        self, mapId, emitterSk, &PositionXYZToXZ (&updatePosEvent->newPosition),
-        COMMANDER_VIEW_RANGE
+    // Update the position in the grid of the map, and get the clients around and the visible set changes
+    if (!(eventServerUpdateClientPosition(
+        self, mapId, emitterSk, &updatePosEvent->newPosition, COMMANDER_VIEW_RANGE,
+        &clientsAround, &pcEnterList, &pcLeaveList
     ))) {
         error("Cannot get clients within range");
         status = false;
         goto cleanup;
     }
-    *_redisClientsAround = redisClientsAround;
-
-    // Get the node of the current client
-    GraphNode *nodeCurrentClient = eventServerGetClientNode (self, emitterSk);
-
-    // Mark the neighbours nodes as unvisited
-    for (GraphArc *neighbourArc = zlist_first(nodeCurrentClient->arcs);
-        neighbourArc != NULL;
-        neighbourArc = zlist_next(nodeCurrentClient->arcs)
-    ) {
-        GraphNode *neighbourNode = neighbourArc->to;
-        GraphNodeClient *neighbourClient = neighbourNode->user_data;
-        neighbourClient->around = false;
+    *_clientsAround = clientsAround;
+    emitterId = eventServerGetClientId(self, emitterSk);
+
+    // Keep the ZC_ENTER_PC of the client at its new position
+    if (!(clientAppearance = zoneEventServerGetClientAppearance(self, emitterSk))) {
+        error("Cannot get the appearance of %s.", emitterSk);
+        status = false;
+        goto cleanup;
     }
+    clientAppearance->position = updatePosEvent->newPosition;
+    zoneBuilderEnterPcUpdatePosition(clientAppearance->enterPcPacket, &clientAppearance->position);
 
-    if (zlist_size(redisClientsAround) > 0)
+    if (pcEnterList->count > 0)
     {
-        pcEnterList = zlist_new();
-
-        // Compare the list from Redis to the list of neighbors from the proximity graph
-        for (uint8_t *redisSocketIdClientAround = zlist_first(redisClientsAround);
-             redisSocketIdClientAround != NULL;
-             redisSocketIdClientAround = zlist_next(redisClientsAround)
-        ) {
-            GraphNode *graphClientAroundNode;
-            if (!(graphClientAroundNode = eventServerGetClientNode (self, redisSocketIdClientAround))) {
-                error("Cannot get the neighbour node %s.", redisSocketIdClientAround);
-                status = false;
-                goto cleanup;
-            }
-
-            if (!(graphNodeGetArc (nodeCurrentClient, graphClientAroundNode))) {
-                // nodeCurrentClient isn't linked yet with its neighbour
-                // It means that the current client has just entered in the neighbour client zone !
-                // Mutually link them together in the graph, and warn the game clients of the arrival of a new client
-                eventServerLinkClients (self, nodeCurrentClient, graphClientAroundNode);
-                zlist_append(pcEnterList, redisSocketIdClientAround);
-            }
-
-            GraphNodeClient *graphNeighbourClient = graphClientAroundNode->user_data;
-            graphNeighbourClient->around = true;
-        }
-
         // Send the ZC_PC_ENTER to clients who now sees the current client
-        if (zlist_size(pcEnterList) > 0) {
-            pcEnterMsg = zmsg_new();
-            zoneBuilderEnterPc(commander, pcEnterMsg);
-            if (!(eventServerSendToClients(self, redisClientsAround, pcEnterMsg))) {
-                error("Failed to send the packet to the clients.");
-                status = false;
-                goto cleanup;
-            }
+        pcEnterMsg = zmsg_new();
+        zmsg_addmem(pcEnterMsg, clientAppearance->enterPcPacket, clientAppearance->enterPcPacketSize);
+        if (!(eventServerSendToClients(self, pcEnterList->ids, pcEnterList->count, pcEnterMsg))) {
+            error("Failed to send the packet to the clients.");
+            status = false;
+            goto cleanup;
         }
 
         // Also, send to the current player the list of entered players
-        for (uint8_t *enterPcSocketId = zlist_first(pcEnterList);
-             enterPcSocketId != NULL;
-             enterPcSocketId = zlist_next(pcEnterList)
-        ) {
-            if (strcmp (enterPcSocketId, emitterSk) == 0) {
-                // Doesn't send again the packet - the client sees himself
-                continue;
-            }
-
-            GameSession gameSession;
-            curPcEnterMsg = zmsg_new();
-            if (!(eventServerGetGameSessionBySocketId(
-                self, eventServerGetRouterId(self), enterPcSocketId, &gameSession)))
-            {
-                error("Cannot get game session from %s.", enterPcSocketId);
+        for (size_t i = 0; i < pcEnterList->count; i++) {
+            ZoneClientAppearance *enterPcAppearance;
+            if (!(enterPcAppearance = zoneEventServerGetClientAppearanceById(self, pcEnterList->ids[i]))) {
+                error("Cannot get the appearance of the client %u.", pcEnterList->ids[i]);
                 status = false;
                 goto cleanup;
             }
 
-            zoneBuilderEnterPc(gameSession.commanderSession.currentCommander, curPcEnterMsg);
-            zframe_t *pcEnterFrame = zmsg_first(curPcEnterMsg);
-            if (!(eventServerSendToClient (self, emitterSk, zframe_data(pcEnterFrame), zframe_size(pcEnterFrame)))) {
+            if (!(eventServerSendToClient(self, emitterId,
+                enterPcAppearance->enterPcPacket, enterPcAppearance->enterPcPacketSize)))
+            {
                 error("Failed to send the packet to the clients.");
                 status = false;
                 goto cleanup;
             }
-
-            zmsg_destroy(&curPcEnterMsg);
-        }
-    }
-
-    // Check for ZC_LEAVE and build a list of clients involved
-    pcLeaveList = zlist_new();
-    for (GraphArc *neighbourArc = zlist_first(nodeCurrentClient->arcs);
-        neighbourArc != NULL;
-        neighbourArc = zlist_next(nodeCurrentClient->arcs)
-    ) {
-        GraphNode *neighbourNode = neighbourArc->to;
-        GraphNodeClient *neighbourClient = neighbourNode->user_data;
-        if (neighbourClient->around == false) {
-            // The neighbour is still marked as "not around" : The current commander left its screen zone
-            eventServerUnlinkClients (self, nodeCurrentClient, neighbourNode);
-            zlist_append(pcLeaveList, neighbourNode->key);
         }
     }
 
     // Send the ZC_LEAVE to the players in the list
-    if (zlist_size(pcLeaveList) > 0)
+    if (pcLeaveList->count > 0)
     {
         pcLeaveMsg = zmsg_new();
-        zoneBuilderLeave(commander->pcId, pcLeaveMsg);
+        zoneBuilderLeave(updatePosEvent->pcId, pcLeaveMsg);
 
-        // Also, send to the current player the list of left players
-        if (!(eventServerSendToClients(self, pcLeaveList, pcLeaveMsg))) {
+        if (!(eventServerSendToClients(self, pcLeaveList->ids, pcLeaveList->count, pcLeaveMsg))) {
             error("Failed to send the packet to the clients.");
             status = false;
             goto cleanup;
         }
 
         // Also, send to the current player the list of left players
-        for (uint8_t *leftPcSocketId = zlist_first(pcLeaveList);
-             leftPcSocketId != NULL;
-             leftPcSocketId = zlist_next(pcLeaveList)
-        ) {
-            GameSession gameSession;
-            curPcLeaveMsg = zmsg_new();
-            if (!(eventServerGetGameSessionBySocketId(
-                self, eventServerGetRouterId(self), leftPcSocketId, &gameSession)))
-            {
-                error("Cannot get game session from %s.", leftPcSocketId);
+        for (size_t i = 0; i < pcLeaveList->count; i++) {
+            ZoneClientAppearance *leftPcAppearance;
+            if (!(leftPcAppearance = zoneEventServerGetClientAppearanceById(self, pcLeaveList->ids[i]))) {
+                error("Cannot get the appearance of the client %u.", pcLeaveList->ids[i]);
                 status = false;
                 goto cleanup;
             }
 
-            zoneBuilderLeave(gameSession.commanderSession.currentCommander->pcId, curPcLeaveMsg);
+            zmsg_t *curPcLeaveMsg = zmsg_new();
+            zoneBuilderLeave(leftPcAppearance->appearance.pcId, curPcLeaveMsg);
             zframe_t *pcLeaveFrame = zmsg_first(curPcLeaveMsg);
-            if (!(eventServerSendToClient (self, emitterSk, zframe_data(pcLeaveFrame), zframe_size(pcLeaveFrame)))) {
+            bool sent = eventServerSendToClient(self, emitterId, zframe_data(pcLeaveFrame), zframe_size(pcLeaveFrame));
+            zmsg_destroy(&curPcLeaveMsg);
+
+            if (!sent) {
                 error("Failed to send the packet to the clients.");
                 status = false;
                 goto cleanup;
             }
-
-            zmsg_destroy(&curPcLeaveMsg);
         }
     }
 
 cleanup:
-    zlist_destroy (&pcLeaveList);
-    zlist_destroy (&pcEnterList);
     zmsg_destroy(&pcLeaveMsg);
-    zmsg_destroy(&curPcLeaveMsg);
     zmsg_destroy(&pcEnterMsg);
-    zmsg_destroy(&curPcEnterMsg);
     return status;
 }
@@ -28,6 +28,16 @@
 #define COMMANDER_VIEW_RANGE 250.0
 
 // ------ Structure declaration -------
+/**
+ * @brief Appearance of a client kept by the EventServer, from its entrance in the zone until it leaves.
+ *        It holds the ZC_ENTER_PC of the client, sent as is to the clients who see it entering.
+ */
+typedef struct {
+    CommanderAppearance appearance;
+    PositionXYZ position;
+    size_t enterPcPacketSize;
+    uint8_t enterPcPacket[0];
+} ZoneClientAppearance;
 
 // ----------- Functions ------------
 /**
@@ -41,14 +51,47 @@ bool zoneEventServerProcess(EventServer *self, EventType type, void *eventData);
  * @param event A game event
  * @param updatePosEvent Contains needed information for updating a commander position
  * @param newPosition The new position of the client
- * @param[out] redisClientsAround The list of other clients around the client at its new position
+ * @param[out] clientsAround The compact IDs of the other clients around the client at its new position
  * @return true on success, false otherwise
  */
 bool zoneEventServerUpdateClientPosition(
     EventServer *self,
     GameEvent *event,
     GameEventUpdatePosition *updatePosEvent,
-    zlist_t **_redisClientsAround);
+    NeighborSet **_clientsAround);
+
+/**
+ * @brief Keep the appearance of a client in the EventServer, and build its ZC_ENTER_PC.
+ *        It replaces the appearance kept before, when the equipment, the stance or the name changed.
+ * @param self A pointer to an allocated EventServer.
+ * @param sessionKey The socketID of the client
+ * @param appearance The new appearance of the client
+ * @param position The current position of the client
+ * @return the appearance kept by the EventServer, or NULL on error
+ */
+ZoneClientAppearance *zoneEventServerSetClientAppearance (
+    EventServer *self,
+    uint8_t *sessionKey,
+    CommanderAppearance *appearance,
+    PositionXYZ *position
+);
+
+/**
+ * @brief Get the appearance of a client kept by the EventServer.
+ *        An unknown appearance is loaded from the game session of the client, and kept for the next events.
+ * @param self A pointer to an allocated EventServer.
+ * @param sessionKey The socketID of the client
+ * @return the appearance of the client, or NULL on error
+ */
+ZoneClientAppearance *zoneEventServerGetClientAppearance(EventServer *self, uint8_t *sessionKey);
+
+/**
+ * @brief Get the appearance of a client kept by the EventServer, from its compact ID.
+ * @param self A pointer to an allocated EventServer.
+ * @param client The compact ID of the client
+ * @return the appearance of the client, or NULL on error
+ */
+ZoneClientAppearance *zoneEventServerGetClientAppearanceById(EventServer *self, ClientId_t client);
 
 /**
  * @brief Event handler when a client disconnects
@@ -60,3 +103,22 @@ bool zoneEventServerOnDisconnect (
     RouterId_t routerId,
     uint8_t *sessionKeyStr
 );
+
+/**
+ * @brief Hand off a client changing of map to the EventServer shard of its new map.
+ *        When the maps are owned by different shards, the shard of the previous map is asked to forget the client.
+ *        This must be dispatched before any event of the client on its new map.
+ * @param eventServer The socket publishing the events
+ * @param sessionKeyStr The socketID of the client
+ * @param pcId The PC of the client
+ * @param fromMapId The previous map of the client
+ * @param toMapId The new map of the client
+ * @return true on success, false otherwise
+ */
+bool zoneEventServerDispatchWarp (
+    zsock_t *eventServer,
+    uint8_t *sessionKeyStr,
+    PcId_t pcId,
+    MapId_t fromMapId,
+    MapId_t toMapId
+);
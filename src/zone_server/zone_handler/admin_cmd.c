@@ -127,11 +127,13 @@ void adminCmdSpawnPc(Worker *self, Session *session, char *args, zmsg_t *replyMs
     GameEventEnterPc event = {
         .updatePosEvent = {
             .mapId = fakeSocketSession.mapId,
-            .commander = fakePc
+            .pcId = fakePc.pcId,
+            .newPosition = fakePc.pos
         }
     };
+    commanderAppearanceInit(&event.appearance, &fakePc);
 
-    workerDispatchEvent(self, sessionKeyStr, EVENT_TYPE_ENTER_PC, &event, sizeof(event));
+    workerDispatchEvent(self, fakeSocketSession.mapId, sessionKeyStr, EVENT_TYPE_ENTER_PC, &event, sizeof(event));
 }
 
 void adminCmdAddItem(Worker *self, Session *session, char *args, zmsg_t *replyMsg) {
@@ -223,16 +225,14 @@ void adminCmdJump(Worker *self, Session *session, char *args, zmsg_t *replyMsg)
 
 void adminCmdTest(Worker *self, Session *session, char *args, zmsg_t *replyMsg) {
     info("Test command launched.");
-    size_t memSize;
-    void *memory = dumpToMem(
-        "[03:12:32][main.c:30 in writePacketToFile]  E9 0C 73 2A 86 02 35 00 A2 4E 00 00 02 01 05 00 | ..s*..5..N......\n"
-        "[03:12:32][main.c:30 in writePacketToFile]  4E 61 6D 65 00 0C 00 44 61 72 6B 48 6F 72 69 7A | Name...DarkHoriz\n"
-        "[03:12:32][main.c:30 in writePacketToFile]  6F 6E 00 04 00 57 68 6F 00 0A 00 4C 6F 74 68 62 | on...Who...Lothb\n"
-        "[03:12:32][main.c:30 in writePacketToFile]  72 6F 6F 6B 00                                  | rook."
-      , NULL, &memSize
-    );
-
-    zmsg_add(replyMsg, zframe_new(memory, memSize));
+    static const uint8_t packetTemplate[] = {
+        0xE9, 0x0C, 0x73, 0x2A, 0x86, 0x02, 0x35, 0x00, 0xA2, 0x4E, 0x00, 0x00, 0x02, 0x01, 0x05, 0x00,
+        0x4E, 0x61, 0x6D, 0x65, 0x00, 0x0C, 0x00, 0x44, 0x61, 0x72, 0x6B, 0x48, 0x6F, 0x72, 0x69, 0x7A,
+        0x6F, 0x6E, 0x00, 0x04, 0x00, 0x57, 0x68, 0x6F, 0x00, 0x0A, 0x00, 0x4C, 0x6F, 0x74, 0x68, 0x62,
+        0x72, 0x6F, 0x6F, 0x6B, 0x00,
+    };
+
+    replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
 }
 
 void adminCmdWhere(Worker *self, Session *session, char *args, zmsg_t *replyMsg) {
@@ -244,7 +244,9 @@ void adminCmdWhere(Worker *self, Session *session, char *args, zmsg_t *replyMsg)
         session->game.commanderSession.currentCommander->mapId,
         position.x, position.y, position.z);
 
-    zoneBuilderChat(session->game.commanderSession.currentCommander, message, replyMsg);
+    CommanderAppearance appearance;
+    commanderAppearanceInit(&appearance, session->game.commanderSession.currentCommander);
+    zoneBuilderChat(&appearance, message, replyMsg);
 }
 
 void adminCmdChangeCamera(Worker *self, Session *session, char *args, zmsg_t *replyMsg) {
@@ -285,7 +287,9 @@ void adminCmdChangeCamera(Worker *self, Session *session, char *args, zmsg_t *re
         }
         else {
             snprintf(message, sizeof(message), "Bad usage /changeCamera <x> <y> <z> {<fspd> <ispd>}");
-            zoneBuilderChat(session->game.commanderSession.currentCommander, message, replyMsg);
+            CommanderAppearance appearance;
+            commanderAppearanceInit(&appearance, session->game.commanderSession.currentCommander);
+            zoneBuilderChat(&appearance, message, replyMsg);
         }
         free(arg);
     }
@@ -399,6 +403,14 @@ void adminCmdSetLevel(Worker *self, Session *session, char *args, zmsg_t *replyM
             info("Setting level to %d.", level);
             session->game.commanderSession.currentCommander->level = level;
             zoneBuilderPCLevelUp(session->game.commanderSession.currentCommander->pcId, level, replyMsg);
+
+            // The level is shown to the clients entering in the view
+            GameEventAppearanceChange event = {
+                .pcId = session->game.commanderSession.currentCommander->pcId
+            };
+            commanderAppearanceInit(&event.appearance, session->game.commanderSession.currentCommander);
+            workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey,
+                EVENT_TYPE_APPEARANCE_CHANGE, &event, sizeof(event));
         }
         free(arg);
     }
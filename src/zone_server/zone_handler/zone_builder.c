@@ -28,7 +28,7 @@ void zoneBuilderRestSit(PcId_t targetPcId, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_REST_SIT;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_REST_SIT);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -56,30 +56,30 @@ void zoneBuilderItemAdd(Item *item, ItemInventoryIndex_t inventoryIndex, Invento
         float notificationDelay;
         uint8_t inventoryType;
         uint8_t properties[propertiesSize];
-    } replyPacket;
+    } *replyPacket;
     #pragma pack(pop)
 
     PacketType packetType = ZC_ITEM_ADD;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, ZC_ITEM_ADD);
 
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
     {
-        variableSizePacketHeaderInit(&replyPacket.variableSizeHeader, packetType, sizeof(replyPacket));
-        replyPacket.item.uid = actorGetUId(item);
-        replyPacket.item.id = itemGetId(item);
-        replyPacket.item.amount = itemGetAmount(item);
-        replyPacket.item.inventoryIndex = inventoryIndex;
-        replyPacket.propertiesSize = propertiesSize;
-        replyPacket.addType = addType;
-        replyPacket.notificationDelay = 0.0f;
-        replyPacket.inventoryType = 0;
+        variableSizePacketHeaderInit(&replyPacket->variableSizeHeader, packetType, sizeof(*replyPacket));
+        replyPacket->item.uid = actorGetUId(item);
+        replyPacket->item.id = itemGetId(item);
+        replyPacket->item.amount = itemGetAmount(item);
+        replyPacket->item.inventoryIndex = inventoryIndex;
+        replyPacket->propertiesSize = propertiesSize;
+        replyPacket->addType = addType;
+        replyPacket->notificationDelay = 0.0f;
+        replyPacket->inventoryType = 0;
 
         PacketStream packetStream;
-        packetStreamInit(&packetStream, replyPacket.properties, sizeof(replyPacket.properties));
+        packetStreamInit(&packetStream, replyPacket->properties, sizeof(replyPacket->properties));
         itemSerializeCPacket(item, &packetStream);
+
+        buffer_print(replyPacket, sizeof(*replyPacket), NULL);
     }
-
-    buffer_print(&replyPacket, sizeof(replyPacket), NULL);
 }
 
 void zoneBuilderSkillReady(
@@ -107,7 +107,7 @@ void zoneBuilderSkillReady(
         5A730100 419C0000 0000803F 011C ECC7 C9EC91C4 74768243 17060AC4 C9EC91C4 74768243 17060AC4
     */
     PacketType packetType = ZC_SKILL_READY;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE_WAIVED(replyPacket, ZC_SKILL_READY);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -139,7 +139,7 @@ void zoneBuilderPlayAni(zmsg_t *replyMsg) {
         4B010000 25182700 01 01 00000000 0000803F
     */
     PacketType packetType = ZC_PLAY_ANI;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_PLAY_ANI);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -172,7 +172,7 @@ void zoneBuilderSkillCast(
     #pragma pack(pop)
 
     PacketType packetType = ZC_SKILL_CAST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SKILL_CAST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -198,7 +198,7 @@ void zoneBuilderPlaySkillCastAni(PcId_t targetPcId, PositionXYZ *position, zmsg_
     #pragma pack(pop)
 
     PacketType packetType = ZC_PLAY_SKILL_CAST_ANI;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_PLAY_SKILL_CAST_ANI);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -225,16 +225,15 @@ void zoneBuilderNormalUnk8(PcId_t targetPcId, zmsg_t *replyMsg) {
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[11:37:20][           ToSClient:                     dbgBuffer]  30 0D FF FF FF FF 59 00 54 00 00 00 36 F8 01 00 | 0.....Y.T...6...\n"
-            "[11:37:20][           ToSClient:                     dbgBuffer]  11 18 27 00 41 9C 00 00 02 00 00 00 BC BD A9 C4 | ..'.A...........\n"
-            "[11:37:20][           ToSClient:                     dbgBuffer]  6A 1F 02 43 57 94 34 C3 4C EF 2E B4 00 00 80 3F | j..CW.4.L......?\n"
-            "[11:37:20][           ToSClient:                     dbgBuffer]  6A 21 22 B4 00 00 A0 41 1A 74 00 00 01 00 00 00 | j!.....A.t......\n"
-            "[11:37:20][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:37:20][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00                      | .........\n"
-          , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x30, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x59, 0x00, 0x54, 0x00, 0x00, 0x00, 0x36, 0xF8, 0x01, 0x00,
+            0x11, 0x18, 0x27, 0x00, 0x41, 0x9C, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0xBC, 0xBD, 0xA9, 0xC4,
+            0x6A, 0x1F, 0x02, 0x43, 0x57, 0x94, 0x34, 0xC3, 0x4C, 0xEF, 0x2E, 0xB4, 0x00, 0x00, 0x80, 0x3F,
+            0x6A, 0x21, 0x22, 0xB4, 0x00, 0x00, 0xA0, 0x41, 0x1A, 0x74, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         replyPacket.pcId = targetPcId;
     }
@@ -254,12 +253,11 @@ void zoneBuilderNormalUnk9(PcId_t targetPcId, zmsg_t *replyMsg) {
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[11:10:23][           ToSClient:                     dbgBuffer]  30 0D 2E D3 5E 00 1D 00 24 01 00 00 5A 73 01 00 | 0...^...$...Zs..\n"
-            "[11:10:23][           ToSClient:                     dbgBuffer]  00 6E 00 00 00 FF FF FF FF 57 04 00 00          | .n.......W...\n"
-          , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x30, 0x0D, 0x2E, 0xD3, 0x5E, 0x00, 0x1D, 0x00, 0x24, 0x01, 0x00, 0x00, 0x5A, 0x73, 0x01, 0x00,
+            0x00, 0x6E, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x57, 0x04, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         replyPacket.pcId = targetPcId;
     }
@@ -299,16 +297,15 @@ void zoneBuilderNormalUnk10_56(
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[03:08:45][main.c:56 in CNetUsr__PacketHandler_1]  33 0D FF FF FF FF 59 00 56 00 00 00 00 00 00 00 | 3.....Y.V.......\n"
-            "[03:08:45][main.c:56 in CNetUsr__PacketHandler_1]  11 18 27 00 41 9C 00 00 01 00 00 00 4F DB 87 C4 | ....A.......O...\n"
-            "[03:08:45][main.c:56 in CNetUsr__PacketHandler_1]  74 76 82 43 14 F4 07 C4 FF FF 7F 3F FF 1F B5 B9 | ...C............\n"
-            "[03:08:45][main.c:56 in CNetUsr__PacketHandler_1]  96 68 26 35 01 00 A0 41 66 68 01 00 01 00 00 00 | .h&5............\n"
-            "[03:08:45][main.c:56 in CNetUsr__PacketHandler_1]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[03:08:45][main.c:56 in CNetUsr__PacketHandler_1]  00 00 00 00 00 00 00 00 00                      | .........\n"
-          , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x59, 0x00, 0x56, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x11, 0x18, 0x27, 0x00, 0x41, 0x9C, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x4F, 0xDB, 0x87, 0xC4,
+            0x74, 0x76, 0x82, 0x43, 0x14, 0xF4, 0x07, 0xC4, 0xFF, 0xFF, 0x7F, 0x3F, 0xFF, 0x1F, 0xB5, 0xB9,
+            0x96, 0x68, 0x26, 0x35, 0x01, 0x00, 0xA0, 0x41, 0x66, 0x68, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         replyPacket.pcId = targetPcId;
         //replyPacket.skillEffectId = SWAP_UINT32(0x11182700);
@@ -354,14 +351,13 @@ void zoneBuilderNormalUnk11_1c(PcId_t targetPcId, PositionXYZ *position, Positio
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  33 0D 9F 0E 14 03 39 00 1C 00 00 00 00 00 00 00 | 3.....9......_..\n"
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  00 A6 9C 77 04 00 00 00 00 6A E7 1B C4 74 76 82 | ...w.....j...tv.\n"
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  43 BB 0E 80 C4 00 00 00 80 FE FF 7F BF 00 00 00 | C...............\n"
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  00 00 00 00 00 00 00 00 00                      | .........\n"
-          , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0x9F, 0x0E, 0x14, 0x03, 0x39, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0xA6, 0x9C, 0x77, 0x04, 0x00, 0x00, 0x00, 0x00, 0x6A, 0xE7, 0x1B, 0xC4, 0x74, 0x76, 0x82,
+            0x43, 0xBB, 0x0E, 0x80, 0xC4, 0x00, 0x00, 0x00, 0x80, 0xFE, 0xFF, 0x7F, 0xBF, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         replyPacket.pcId = targetPcId;
         replyPacket.unk1 = 0;
@@ -389,12 +385,11 @@ void zoneBuilderNormalUnk12_60(ActorId_t actorId, zmsg_t *replyMsg) {
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  33 0D 7A 1A 14 03 14 00 60 00 00 00 27 68 01 00 | 3.....9......_..\n"
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  01 00 00 00                                     | ...w.....j...tv.\n"
-          , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0x7A, 0x1A, 0x14, 0x03, 0x14, 0x00, 0x60, 0x00, 0x00, 0x00, 0x27, 0x68, 0x01, 0x00,
+            0x01, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         replyPacket.pcId = actorId;
         replyPacket.unk1 = 1;
@@ -417,12 +412,11 @@ void zoneBuilderNormalUnk13_85(ActorId_t actorId, zmsg_t *replyMsg) {
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  33 0D A6 13 14 03 19 00 85 00 00 00 27 68 01 00 | 3.....9......_..\n"
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  66 EA 00 00 01 00 00 00 00                      | ...w.....j...tv.\n"
-          , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xA6, 0x13, 0x14, 0x03, 0x19, 0x00, 0x85, 0x00, 0x00, 0x00, 0x27, 0x68, 0x01, 0x00,
+            0x66, 0xEA, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(packetTemplate));
 
         replyPacket.actorId = actorId;
         replyPacket.unk1 = SWAP_UINT32(0x66EA0000);
@@ -445,12 +439,11 @@ void zoneBuilderNormalUnk14_4c(PcId_t pcId, SkillId_t skillId, zmsg_t *replyMsg)
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  33 0D A6 13 14 03 19 00 4C 00 00 00 27 68 01 00 | 3.....9......_..\n"
-            "[03:07:53][main.c:56 in CNetUsr__PacketHandler_1]  66 EA 00 00                                     | ...w.....j...tv.\n"
-          , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xA6, 0x13, 0x14, 0x03, 0x19, 0x00, 0x4C, 0x00, 0x00, 0x00, 0x27, 0x68, 0x01, 0x00,
+            0x66, 0xEA, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         replyPacket.pcId = pcId;
         replyPacket.skillId = skillId;
@@ -471,33 +464,31 @@ void zoneBuilderPartyList(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[11:10:22][           ToSClient:                     dbgBuffer]  82 0C FF FF FF FF 44 01 00 00 34 54 A3 00 00 00 | ......D...4T....\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 16 00 00 00 13 9D 01 00 34 35 34 31 37 39 | ..........454179\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  01 30 36 36 35 30 31 33 D1 A8 01 44 00 00 00 00 | .0665013...D....\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  EA B5 AC EC 9B 90 EC 9E 90 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  F3 D4 56 00 30 35 E3 13 0B 05 04 00 46 CF 01 00 | ..V.05......F...\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  EA B5 AC EC 9B 90 EC 9E 90 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  43 42 54 EC 9A A9 00 00 00 00 00 00 00 00 00 00 | CBT.............\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 DB 1F 00 0C 00 00 00 01 2E 55 00 45 95 09 00 | ..........U.E...\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  4A 00 00 00 00 00 B4 C2 00 40 A2 44 00 D0 0A C5 | J........@.D....\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  EC 01 00 00 24 04 00 00 EC 01 00 00 24 04 00 00 | ....$.......$...\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  12 00 84 1B 00 80 9D 46 76 1B 00 68 97 46 85 1B | .......Fv..h.F..\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  18 72 BE 49                                     | .r.I\n"
-            , NULL, &memSize
-        );
-
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        static const uint8_t packetTemplate[] = {
+            0x82, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x44, 0x01, 0x00, 0x00, 0x34, 0x54, 0xA3, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x13, 0x9D, 0x01, 0x00, 0x34, 0x35, 0x34, 0x31, 0x37, 0x39,
+            0x01, 0x30, 0x36, 0x36, 0x35, 0x30, 0x31, 0x33, 0xD1, 0xA8, 0x01, 0x44, 0x00, 0x00, 0x00, 0x00,
+            0xEA, 0xB5, 0xAC, 0xEC, 0x9B, 0x90, 0xEC, 0x9E, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0xF3, 0xD4, 0x56, 0x00, 0x30, 0x35, 0xE3, 0x13, 0x0B, 0x05, 0x04, 0x00, 0x46, 0xCF, 0x01, 0x00,
+            0xEA, 0xB5, 0xAC, 0xEC, 0x9B, 0x90, 0xEC, 0x9E, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x43, 0x42, 0x54, 0xEC, 0x9A, 0xA9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0xDB, 0x1F, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x01, 0x2E, 0x55, 0x00, 0x45, 0x95, 0x09, 0x00,
+            0x4A, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB4, 0xC2, 0x00, 0x40, 0xA2, 0x44, 0x00, 0xD0, 0x0A, 0xC5,
+            0xEC, 0x01, 0x00, 0x00, 0x24, 0x04, 0x00, 0x00, 0xEC, 0x01, 0x00, 0x00, 0x24, 0x04, 0x00, 0x00,
+            0x12, 0x00, 0x84, 0x1B, 0x00, 0x80, 0x9D, 0x46, 0x76, 0x1B, 0x00, 0x68, 0x97, 0x46, 0x85, 0x1B,
+            0x18, 0x72, 0xBE, 0x49,
+        };
+
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -511,23 +502,21 @@ void zoneBuilderPartyInfo(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[11:10:22][           ToSClient:                     dbgBuffer]  81 0C FF FF FF FF A4 00 00 00 34 54 A3 00 00 00 | ..........4T....\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 16 00 00 00 13 9D 01 00 34 35 34 31 37 39 | ..........454179\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  39 30 36 36 35 30 31 33 34 00 36 00 36 00 35 00 | 906650134.6.6.5.\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  30 00 31 00 33 00 34 00 00 00 00 00 00 00 00 00 | 0.1.3.4.........\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 D1 A8 01 44 00 00 00 00 EA B5 AC EC 9B 90 | .....D..........\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  EC 9E 90 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 02 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00                                     | ....\n"
-            , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x81, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xA4, 0x00, 0x00, 0x00, 0x34, 0x54, 0xA3, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x13, 0x9D, 0x01, 0x00, 0x34, 0x35, 0x34, 0x31, 0x37, 0x39,
+            0x39, 0x30, 0x36, 0x36, 0x35, 0x30, 0x31, 0x33, 0x34, 0x00, 0x36, 0x00, 0x36, 0x00, 0x35, 0x00,
+            0x30, 0x00, 0x31, 0x00, 0x33, 0x00, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0xD1, 0xA8, 0x01, 0x44, 0x00, 0x00, 0x00, 0x00, 0xEA, 0xB5, 0xAC, 0xEC, 0x9B, 0x90,
+            0xEC, 0x9E, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+            0x00, 0x00, 0x00, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -541,13 +530,11 @@ void zoneBuilderJobPts(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[11:10:22][           ToSClient:                     dbgBuffer]  18 0D FF FF FF FF 04 00 01 00                   | .........."
-            , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x18, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0x00, 0x01, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -566,29 +553,28 @@ void zoneBuilderNormalUnk7(
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[11:10:22][           ToSClient:                     dbgBuffer]  30 0D FF FF FF FF 25 01 E1 00 00 00 00 16 00 00 | 0.....%.........\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 13 9D 01 00 D1 A8 01 44 00 00 00 00 D1 A8 01 | ........D.......\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  44 00 00 00 00 EA B5 AC EC 9B 90 EC 9E 90 00 00 | D...............\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 F3 D4 56 00 30 35 E3 13 FD 03 09 | .......V.05.....\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  B8 5A 73 01 00 EA B5 AC EC 9B 90 EC 9E 90 00 00 | .Zs.............\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 43 42 54 32 00 00 00 00 00 00 00 | .....CBT2.......\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 04 00 01 00 00 00 02 33 56 | ..............3V\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 01 00 00 00 00 00 1D C4 00 00 82 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  43 00 20 80 C4 69 00 00 00 77 00 00 00 69 00 00 | C. ..i...w...i..\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 77 00 00 00                                  | .w...\n"
-            , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x30, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x25, 0x01, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00,
+            0x00, 0x13, 0x9D, 0x01, 0x00, 0xD1, 0xA8, 0x01, 0x44, 0x00, 0x00, 0x00, 0x00, 0xD1, 0xA8, 0x01,
+            0x44, 0x00, 0x00, 0x00, 0x00, 0xEA, 0xB5, 0xAC, 0xEC, 0x9B, 0x90, 0xEC, 0x9E, 0x90, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0xF3, 0xD4, 0x56, 0x00, 0x30, 0x35, 0xE3, 0x13, 0xFD, 0x03, 0x09,
+            0xB8, 0x5A, 0x73, 0x01, 0x00, 0xEA, 0xB5, 0xAC, 0xEC, 0x9B, 0x90, 0xEC, 0x9E, 0x90, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0x42, 0x54, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x33, 0x56,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xC4, 0x00, 0x00, 0x82,
+            0x43, 0x00, 0x20, 0x80, 0xC4, 0x69, 0x00, 0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x69, 0x00, 0x00,
+            0x00, 0x77, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
     }
 }
 
@@ -610,25 +596,24 @@ void zoneBuilderNormalUnk6(char *commanderName, zmsg_t *replyMsg) {
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[11:10:22][           ToSClient:                     dbgBuffer]  30 0D FF FF FF FF E9 00 C9 00 00 00 85 07 00 00 | 0...............\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  19 51 00 00 43 22 00 00 1C 08 00 00 FF FF FF FF | .Q..C...........\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 01 43 42 54 32 00 00 00 | .........CBT2...\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 00 | ................\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 00 00 00 00 00 00 00 00 00 20 04 00 00 00 00 | .......... .....\n"
-            "[11:10:22][           ToSClient:                     dbgBuffer]  00 02 33 00 00 00 00 00 00                      | ..3......\n"
-            , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x30, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0xE9, 0x00, 0xC9, 0x00, 0x00, 0x00, 0x85, 0x07, 0x00, 0x00,
+            0x19, 0x51, 0x00, 0x00, 0x43, 0x22, 0x00, 0x00, 0x1C, 0x08, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x43, 0x42, 0x54, 0x32, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x04, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x02, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         strncpy(replyPacket.commanderName, commanderName, sizeof(replyPacket.commanderName));
     }
@@ -646,16 +631,14 @@ void zoneBuilderFaction(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     // PacketType packetType = ZC_FACTION;
-    // CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    // CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_FACTION);
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[11:10:22][           ToSClient:                     dbgBuffer]  6B 0D FF FF FF FF 48 01 00 00 CE 18 27 00       | k.....H.....'."
-            , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x6B, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x48, 0x01, 0x00, 0x00, 0xCE, 0x18, 0x27, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -668,24 +651,22 @@ void zoneBuilderEnterMonster(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     // PacketType packetType = ZC_ENTER_MONSTER;
-    // CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    // CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ENTER_MONSTER);
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  BF 0B FF FF FF FF 84 00 48 01 00 00 00 40 23 C4 | ........H....@#.\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  A7 69 82 43 00 40 6E C4 46 0B 51 32 00 00 80 BF | .i.C.@n.F.Q2....\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  02 00 21 00 00 00 21 00 00 00 00 00 00 00 00 00 | ..!...!.........\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  30 4E 00 00 58 02 00 00 21 00 00 00 00 00 69 6F | 0N..X...!.....io\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  01 00 00 00 00 00 80 3F 00 00 00 00 08 00 00 00 | .......?........\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  28 00 00 00 06 00 0A 00 EA B2 BD EA B3 84 EB B3 | ................\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  91 00 01 00 00 11 00 53 49 41 55 5F 46 52 4F 4E | .......SIAU_FRON\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  5F 4E 50 43 5F 30 31 00 01 00 00 01 00 00 07 00 | _NPC_01.........\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  00 00 A0 42                                     | ...B\n"
-            , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0xBF, 0x0B, 0xFF, 0xFF, 0xFF, 0xFF, 0x84, 0x00, 0x48, 0x01, 0x00, 0x00, 0x00, 0x40, 0x23, 0xC4,
+            0xA7, 0x69, 0x82, 0x43, 0x00, 0x40, 0x6E, 0xC4, 0x46, 0x0B, 0x51, 0x32, 0x00, 0x00, 0x80, 0xBF,
+            0x02, 0x00, 0x21, 0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x30, 0x4E, 0x00, 0x00, 0x58, 0x02, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x69, 0x6F,
+            0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+            0x28, 0x00, 0x00, 0x00, 0x06, 0x00, 0x0A, 0x00, 0xEA, 0xB2, 0xBD, 0xEA, 0xB3, 0x84, 0xEB, 0xB3,
+            0x91, 0x00, 0x01, 0x00, 0x00, 0x11, 0x00, 0x53, 0x49, 0x41, 0x55, 0x5F, 0x46, 0x52, 0x4F, 0x4E,
+            0x5F, 0x4E, 0x50, 0x43, 0x5F, 0x30, 0x31, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x07, 0x00,
+            0x00, 0x00, 0xA0, 0x42,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -705,32 +686,33 @@ void zoneBuilderSkillAdd(SkillId_t skillId, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     // PacketType packetType = ZC_SKILL_ADD;
-    // CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    // CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SKILL_ADD);
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        memory = dumpToMem(
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  34 0C FF FF FF FF A2 00 01 01 00 00 00 00 00 00 | 4...............\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  00 00 8F 72 07 00 46 01 00 00 AA 9C 00 00 78 00 | ...r..F...A...x.\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  CC D1 00 00 00 00 54 49 34 D0 BF 0F 00 00 80 3F | ......TI4......?\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  B4 0F 00 E0 AB 46 B8 0F 00 00 00 00 B7 0F 00 00 | .....F..........\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  C8 42 B5 0F 00 00 00 00 BE 0F 00 00 60 41 09 10 | .B...........A..\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  00 00 40 41 33 10 00 00 00 00 3D 10 00 00 80 40 | ...A3.....=.....\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  E4 0F 00 00 7A 43 DE 0F 00 00 80 3F 41 10 00 00 | ....zC......A...\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  00 00 16 10 00 00 00 00 06 10 00 00 C8 42 58 10 | .............BX.\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  00 00 00 00 CB 0F 00 00 00 00 57 10 00 00 80 3F | ..........W.....\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  DA 0F 00 00 1C 42 59 10 00 40 9C 45 5A 10 00 00 | .....BY..@.EZ...\n"
-            "[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  80 3F                                           | ..\n"
+        static const uint8_t packetTemplate[] = {
+            0x34, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xA2, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x8F, 0x72, 0x07, 0x00, 0x46, 0x01, 0x00, 0x00, 0xAA, 0x9C, 0x00, 0x00, 0x78, 0x00,
+            0xCC, 0xD1, 0x00, 0x00, 0x00, 0x00, 0x54, 0x49, 0x34, 0xD0, 0xBF, 0x0F, 0x00, 0x00, 0x80, 0x3F,
+            0xB4, 0x0F, 0x00, 0xE0, 0xAB, 0x46, 0xB8, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xB7, 0x0F, 0x00, 0x00,
+            0xC8, 0x42, 0xB5, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xBE, 0x0F, 0x00, 0x00, 0x60, 0x41, 0x09, 0x10,
+            0x00, 0x00, 0x40, 0x41, 0x33, 0x10, 0x00, 0x00, 0x00, 0x00, 0x3D, 0x10, 0x00, 0x00, 0x80, 0x40,
+            0xE4, 0x0F, 0x00, 0x00, 0x7A, 0x43, 0xDE, 0x0F, 0x00, 0x00, 0x80, 0x3F, 0x41, 0x10, 0x00, 0x00,
+            0x00, 0x00, 0x16, 0x10, 0x00, 0x00, 0x00, 0x00, 0x06, 0x10, 0x00, 0x00, 0xC8, 0x42, 0x58, 0x10,
+            0x00, 0x00, 0x00, 0x00, 0xCB, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x57, 0x10, 0x00, 0x00, 0x80, 0x3F,
+            0xDA, 0x0F, 0x00, 0x00, 0x1C, 0x42, 0x59, 0x10, 0x00, 0x40, 0x9C, 0x45, 0x5A, 0x10, 0x00, 0x00,
+            0x80, 0x3F,
             // ZC_JOB_PTS // Add Skill Points (last 00 00 are the amount of points)
             //"[03:07:52][main.c:56 in CNetUsr__PacketHandler_1]  1B 0D FF FF FF FF A1 0F FF 00                 | ..\n"
-            , NULL, &memSize
-        );
+        };
+        uint8_t packet[sizeof(packetTemplate)];
+        memcpy(packet, packetTemplate, sizeof(packet));
+        memory = (void *) packet;
 
         memory->skillId = skillId;
 
-        buffer_print(memory, memSize, NULL);
+        buffer_print(packet, sizeof(packet), NULL);
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packet, sizeof(packet));
     }
 }
 
@@ -743,7 +725,7 @@ void zoneBuilderLoginTime(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_LOGIN_TIME;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_LOGIN_TIME);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -760,8 +742,7 @@ void zoneBuilderStamina(Stamina_t stamina, zmsg_t *replyMsg) {
     } replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_STAMINA;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_STAMINA);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -778,8 +759,7 @@ void zoneBuilderAddStamina(Stamina_t stamina, zmsg_t *replyMsg) {
     } replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_ADD_STAMINA;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ADD_STAMINA);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -799,8 +779,7 @@ void zoneBuilderUpdateSP(PcId_t targetPcId, Sp_t sp, zmsg_t *replyMsg) {
     } replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_UPDATE_SP;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_UPDATE_SP);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -830,8 +809,7 @@ void zoneBuilderUpdateAllStatus(
     } replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_UPDATE_ALL_STATUS;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_UPDATE_ALL_STATUS);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -854,8 +832,7 @@ void zoneBuilderPCLevelUp(PcId_t targetPcId, CommanderLevel_t level, zmsg_t *rep
     } replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_PC_LEVELUP;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_PC_LEVELUP);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -876,8 +853,7 @@ void zoneBuilderAddHp(PcId_t targetPcId, Hp_t currentHp, Hp_t maxHp, zmsg_t *rep
     } replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_ADD_HP;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ADD_HP);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -899,16 +875,14 @@ void zoneBuilderBuffList(PcId_t targetPcId, zmsg_t *replyMsg) {
     } replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_BUFF_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_BUFF_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[11:10:22][           ToSClient:                     dbgBuffer]  E2 0B FF FF FF FF 0D 00 5A 73 01 00 00          | ........Zs...\n"
-            , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0xE2, 0x0B, 0xFF, 0xFF, 0xFF, 0xFF, 0x0D, 0x00, 0x5A, 0x73, 0x01, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         replyPacket.pcId = targetPcId;
     }
@@ -920,82 +894,89 @@ void zoneBuilderLeave(PcId_t targetPcId, zmsg_t *replyMsg) {
         ServerPacketHeader header;
         PcId_t pcId;
         uint16_t unk1;
-    } replyPacket;
+    } *replyPacket;
     #pragma pack(pop)
 
-    PacketType packetType = ZC_LEAVE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, ZC_LEAVE);
 
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
     {
-        replyPacket.header.type = ZC_LEAVE;
-        replyPacket.pcId = targetPcId;
-        replyPacket.unk1 = 1;
+        replyPacket->header.type = ZC_LEAVE;
+        replyPacket->pcId = targetPcId;
+        replyPacket->unk1 = 1;
     }
 }
 
 void zoneBuilderCampInfo(uint64_t accountId, zmsg_t *replyMsg) {}
 
-void zoneBuilderEnterPc(Commander *commander, zmsg_t *replyMsg) {
-    #pragma pack(push, 1)
-    struct {
-        ServerPacketHeader header;
-        PcId_t pcId; // A65F0B00
-        PositionXYZ position; // 00001DC4, 00008243, 002080C4
-        float unk1; // 0000803F
-        uint32_t unk2; // 00000000
-        uint16_t unk3; // 0000
-        SocialInfoId_t socialInfoId; // EE2500003C010000
-        uint8_t pose; // 00
-        float moveSpeed; // 0000F841
-        uint32_t unk5; // 00000000
-        uint32_t currentHP; // EE00
-        uint32_t maxHP; // EE00
-        uint16_t currentSP; // 6900
-        uint16_t maxSP; // 6900
-        uint32_t currentStamina; // A8610000
-        uint32_t maxStamina; // A8610000
-        uint8_t unk6; // 00
-        uint16_t unk7; // 0000
-        uint32_t titleAchievmentId; // 24B42B1B
-        uint32_t unk9; // FFFFFFFF
-        uint8_t unk10; // 00
-        CommanderAppearanceCPacket appearance;
-        uint8_t partyName[48+1]; // "None"
-    } replyPacket;
-    #pragma pack(pop)
+/** ZC_ENTER_PC packet, kept by the EventServer with the appearance of the commanders */
+#pragma pack(push, 1)
+typedef struct {
+    ServerPacketHeader header;
+    PcId_t pcId; // A65F0B00
+    PositionXYZ position; // 00001DC4, 00008243, 002080C4
+    float unk1; // 0000803F
+    uint32_t unk2; // 00000000
+    uint16_t unk3; // 0000
+    SocialInfoId_t socialInfoId; // EE2500003C010000
+    uint8_t pose; // 00
+    float moveSpeed; // 0000F841
+    uint32_t unk5; // 00000000
+    uint32_t currentHP; // EE00
+    uint32_t maxHP; // EE00
+    uint16_t currentSP; // 6900
+    uint16_t maxSP; // 6900
+    uint32_t currentStamina; // A8610000
+    uint32_t maxStamina; // A8610000
+    uint8_t unk6; // 00
+    uint16_t unk7; // 0000
+    uint32_t titleAchievmentId; // 24B42B1B
+    uint32_t unk9; // FFFFFFFF
+    uint8_t unk10; // 00
+    CommanderAppearanceCPacket appearance;
+    uint8_t partyName[48+1]; // "None"
+} ZcEnterPcPacket;
+#pragma pack(pop)
+
+void zoneBuilderEnterPc(CommanderAppearance *appearance, PositionXYZ *position, zmsg_t *replyMsg) {
+    ZcEnterPcPacket *replyPacket;
 
     PacketType packetType = ZC_ENTER_PC;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
-
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
-    {
-        serverPacketHeaderInit(&replyPacket.header, packetType);
-        replyPacket.pcId = commander->pcId;
-        replyPacket.position = commander->pos;
-        replyPacket.unk1 = 1.0f;
-        replyPacket.unk2 = 0;
-        replyPacket.unk3 = 0;
-        replyPacket.socialInfoId = commander->socialInfoId;
-        replyPacket.pose = 0;
-        replyPacket.moveSpeed = 31.0f; // TODO : store this in CommanderSession
-        replyPacket.currentHP = commander->currentHP;
-        replyPacket.maxHP = commander->maxHP;
-        replyPacket.currentSP = commander->currentSP;
-        replyPacket.maxSP = commander->maxSP;
-        replyPacket.currentStamina = commander->currentStamina;
-        replyPacket.maxStamina = commander->maxStamina;
-        replyPacket.unk6 = 0;
-        replyPacket.unk7 = 0;
-        replyPacket.titleAchievmentId = SWAP_UINT32(0xA1860100); // ICBT, "Hunter"
-        replyPacket.unk9 = -1;
-        replyPacket.unk10 = 0;
-        commanderAppearanceCPacketInit(&replyPacket.appearance,
-            commander->familyName, commander->commanderName,
-            commander->accountId, commander->classId, commander->jobId,
-            commander->gender, commander->level, commander->hairId, commander->pose);
-        strncpy(replyPacket.partyName, "None", sizeof(replyPacket.partyName));
-    }
+    CHECK_SERVER_PACKET_SIZE_WAIVED(*replyPacket, ZC_ENTER_PC);
+
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
+    {
+        serverPacketHeaderInit(&replyPacket->header, packetType);
+        replyPacket->pcId = appearance->pcId;
+        replyPacket->position = *position;
+        replyPacket->unk1 = 1.0f;
+        replyPacket->unk2 = 0;
+        replyPacket->unk3 = 0;
+        replyPacket->socialInfoId = appearance->socialInfoId;
+        replyPacket->pose = 0;
+        replyPacket->moveSpeed = 31.0f; // TODO : store this in CommanderSession
+        replyPacket->currentHP = appearance->currentHP;
+        replyPacket->maxHP = appearance->maxHP;
+        replyPacket->currentSP = appearance->currentSP;
+        replyPacket->maxSP = appearance->maxSP;
+        replyPacket->currentStamina = appearance->currentStamina;
+        replyPacket->maxStamina = appearance->maxStamina;
+        replyPacket->unk6 = 0;
+        replyPacket->unk7 = 0;
+        replyPacket->titleAchievmentId = SWAP_UINT32(0xA1860100); // ICBT, "Hunter"
+        replyPacket->unk9 = -1;
+        replyPacket->unk10 = 0;
+        commanderAppearanceCPacketInit(&replyPacket->appearance,
+            appearance->familyName, appearance->commanderName,
+            appearance->accountId, appearance->classId, appearance->jobId,
+            appearance->gender, appearance->level, appearance->hairId, appearance->pose);
+        strncpy(replyPacket->partyName, "None", sizeof(replyPacket->partyName));
+    }
+}
+
+void zoneBuilderEnterPcUpdatePosition(uint8_t *enterPcPacket, PositionXYZ *position) {
+    ZcEnterPcPacket *packet = (void *) enterPcPacket;
+    packet->position = *position;
 }
 
 void zoneBuilderObjectProperty(ActorId_t actorId, zmsg_t *replyMsg) {
@@ -1051,7 +1032,7 @@ void zoneBuilderObjectProperty(ActorId_t actorId, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_OBJECT_PROPERTY;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_OBJECT_PROPERTY);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1072,17 +1053,15 @@ void zoneBuilderAddonMsg(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     // PacketType packetType = ZC_ADDON_MSG;
-    // CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    // CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ADDON_MSG);
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[11:10:23][           ToSClient:                     dbgBuffer]  4F 0C FF FF FF FF 1F 00 11 00 00 00 00 00 4B 45 | O.............KE\n"
-            "[11:10:23][           ToSClient:                     dbgBuffer]  59 42 4F 41 52 44 5F 54 55 54 4F 52 49 41 4C    | YBOARD_TUTORIAL"
-            , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x4F, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0x45,
+            0x59, 0x42, 0x4F, 0x41, 0x52, 0x44, 0x5F, 0x54, 0x55, 0x54, 0x4F, 0x52, 0x49, 0x41, 0x4C,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -1097,14 +1076,12 @@ void zoneBuilderNormalUnk5(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  33 0D FF FF FF FF 1D 00 21 01 00 00 8D FA 0D 00 | 3.......!.......\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  7B A7 CA C0 60 C3 C8 C0 00 44 20 00 00          | {...`....D ..\n"
-          , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x1D, 0x00, 0x21, 0x01, 0x00, 0x00, 0x8D, 0xFA, 0x0D, 0x00,
+            0x7B, 0xA7, 0xCA, 0xC0, 0x60, 0xC3, 0xC8, 0xC0, 0x00, 0x44, 0x20, 0x00, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -1121,16 +1098,17 @@ void zoneBuilderNormalUnk4(SocialInfoId_t socialInfoId, zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  33 0D FF FF FF FF 2C 00 E6 00 00 00 EE 25 00 00 | 3.....,......%..\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  3C 01 00 00 01 00 00 00 01 00 00 00 A1 0F 01 00 | <...............\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  00 00 00 00 80 1D 61 60 E7 D2 D0 01             | ......a`....\n"
-          , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x2C, 0x00, 0xE6, 0x00, 0x00, 0x00, 0xEE, 0x25, 0x00, 0x00,
+            0x3C, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xA1, 0x0F, 0x01, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x80, 0x1D, 0x61, 0x60, 0xE7, 0xD2, 0xD0, 0x01,
+        };
+        uint8_t packet[sizeof(packetTemplate)];
+        memcpy(packet, packetTemplate, sizeof(packet));
+        memory = (void *) packet;
 
         memory->socialInfoId = socialInfoId;
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packet, sizeof(packet));
     }
 }
 
@@ -1144,13 +1122,11 @@ void zoneBuilderNormalUnk3(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  33 0D FF FF FF FF 10 00 D9 00 00 00 00 00 00 00 | 3...............\n"
-          , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0x00, 0xD9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -1165,14 +1141,12 @@ void zoneBuilderNormalUnk2(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  33 0D FF FF FF FF 18 00 CA 00 00 00 EE 25 00 00 | 3............%..\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  3C 01 00 00 00 00 00 00                         | <.......\n"
-          , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x18, 0x00, 0xCA, 0x00, 0x00, 0x00, 0xEE, 0x25, 0x00, 0x00,
+            0x3C, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -1187,14 +1161,12 @@ void zoneBuilderNormalUnk1(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  33 0D FF FF FF FF 11 00 97 00 00 00 00 00 00 00 | 3...............\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  00                                              | .\n"
-          , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x11, 0x00, 0x97, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -1216,7 +1188,7 @@ void zoneBuilderStartGame(
     #pragma pack(pop)
 
     PacketType packetType = ZC_START_GAME;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_START_GAME);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1239,7 +1211,7 @@ void zoneBuilderQuickSlotList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_QUICK_SLOT_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_QUICK_SLOT_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1260,7 +1232,7 @@ void zoneBuilderCooldownList(SocialInfoId_t socialInfoId, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_COOLDOWN_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_COOLDOWN_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1281,15 +1253,14 @@ void zoneBuilderAbilityList(PcId_t targetPcId, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_ABILITY_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ABILITY_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize = sizeof(replyPacket);
-        dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  35 0C FF FF FF FF 0E 00 A6 5F 0B 00 00 00       | 5........_....\n"
-            , &replyPacket, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x35, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x0E, 0x00, 0xA6, 0x5F, 0x0B, 0x00, 0x00, 0x00,
+        };
+        memcpy(&replyPacket, packetTemplate, sizeof(replyPacket));
 
         variableSizePacketHeaderInit(&replyPacket.variableSizeHeader, packetType, sizeof(replyPacket));
         replyPacket.pcId = targetPcId;
@@ -1304,33 +1275,32 @@ void zoneBuilderSkillList(PcId_t targetPcId, zmsg_t *replyMsg) {
         PcId_t pcId;
         uint16_t skillCount;
         Zlib zlibData;
-    } replyPacket, *memory;
+    } *memory;
     #pragma pack(pop)
-    (void) replyPacket;
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        memory = dumpToMem(
-			"[03:07:40][main.c:30 in writePacketToFile]  33 0C FF FF FF FF D2 00 A6 5F 0B 00 07 00 8D FA | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  C0 00 63 60 80 80 54 20 55 01 65 83 A8 FD FC 0C | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  0C 0D F6 5B F8 19 12 5E B9 ED 00 B2 19 18 B6 03 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  C9 13 4E 5B C1 EC 7D 20 59 07 4E 01 90 B8 B1 00 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  43 83 B5 AB 2D 90 ED E0 F0 04 2C 7B 0F 24 6B EF | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  08 96 15 03 93 6C 40 F2 84 53 04 98 7D 1A AC 26 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  1C CC BE 05 66 47 82 D9 51 40 B2 C1 9E 01 0A 32 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  81 34 56 F7 00 C5 09 BA 87 A1 CA 85 DA EE C9 A1 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  C8 3D 0C 0C D4 76 4F 3A 2E F7 24 64 B9 13 0C 1F | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  07 19 37 6A BB 47 04 97 7B B0 C4 D7 03 47 50 FA | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  49 70 84 A7 1F A0 1A D2 DC F3 C1 91 50 FA 61 C6 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  E9 9E 69 CE E8 E1 C3 E3 44 A9 7B 78 9C 08 B9 27 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  05 A7 7B 30 D3 B3 02 D8 3D 07 28 08 9F 13 38 C3 | \n"
-			"[03:07:40][main.c:30 in writePacketToFile]  07 00                                           | \n"
-          , NULL, &memSize
-        );
-        memory->pcId = targetPcId;
-
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        static const uint8_t packetTemplate[] = {
+            0x33, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xD2, 0x00, 0xA6, 0x5F, 0x0B, 0x00, 0x07, 0x00, 0x8D, 0xFA,
+            0xC0, 0x00, 0x63, 0x60, 0x80, 0x80, 0x54, 0x20, 0x55, 0x01, 0x65, 0x83, 0xA8, 0xFD, 0xFC, 0x0C,
+            0x0C, 0x0D, 0xF6, 0x5B, 0xF8, 0x19, 0x12, 0x5E, 0xB9, 0xED, 0x00, 0xB2, 0x19, 0x18, 0xB6, 0x03,
+            0xC9, 0x13, 0x4E, 0x5B, 0xC1, 0xEC, 0x7D, 0x20, 0x59, 0x07, 0x4E, 0x01, 0x90, 0xB8, 0xB1, 0x00,
+            0x43, 0x83, 0xB5, 0xAB, 0x2D, 0x90, 0xED, 0xE0, 0xF0, 0x04, 0x2C, 0x7B, 0x0F, 0x24, 0x6B, 0xEF,
+            0x08, 0x96, 0x15, 0x03, 0x93, 0x6C, 0x40, 0xF2, 0x84, 0x53, 0x04, 0x98, 0x7D, 0x1A, 0xAC, 0x26,
+            0x1C, 0xCC, 0xBE, 0x05, 0x66, 0x47, 0x82, 0xD9, 0x51, 0x40, 0xB2, 0xC1, 0x9E, 0x01, 0x0A, 0x32,
+            0x81, 0x34, 0x56, 0xF7, 0x00, 0xC5, 0x09, 0xBA, 0x87, 0xA1, 0xCA, 0x85, 0xDA, 0xEE, 0xC9, 0xA1,
+            0xC8, 0x3D, 0x0C, 0x0C, 0xD4, 0x76, 0x4F, 0x3A, 0x2E, 0xF7, 0x24, 0x64, 0xB9, 0x13, 0x0C, 0x1F,
+            0x07, 0x19, 0x37, 0x6A, 0xBB, 0x47, 0x04, 0x97, 0x7B, 0xB0, 0xC4, 0xD7, 0x03, 0x47, 0x50, 0xFA,
+            0x49, 0x70, 0x84, 0xA7, 0x1F, 0xA0, 0x1A, 0xD2, 0xDC, 0xF3, 0xC1, 0x91, 0x50, 0xFA, 0x61, 0xC6,
+            0xE9, 0x9E, 0x69, 0xCE, 0xE8, 0xE1, 0xC3, 0xE3, 0x44, 0xA9, 0x7B, 0x78, 0x9C, 0x08, 0xB9, 0x27,
+            0x05, 0xA7, 0x7B, 0x30, 0xD3, 0xB3, 0x02, 0xD8, 0x3D, 0x07, 0x28, 0x08, 0x9F, 0x13, 0x38, 0xC3,
+            0x07, 0x00,
+        };
+        // The template is copied straight into the reply
+        if ((memory = replyWriterReserve(replyMsg, sizeof(packetTemplate)))) {
+            memcpy(memory, packetTemplate, sizeof(packetTemplate));
+            memory->pcId = targetPcId;
+        }
     }
 }
 
@@ -1380,7 +1350,7 @@ void zoneBuilderItemEquipList(Inventory *inventory, zmsg_t *replyMsg) {
     packetStreamInit(&packetStream, &replyPacket, sizeof(replyPacket));
 
     PacketType packetType = ZC_ITEM_EQUIP_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ITEM_EQUIP_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1438,7 +1408,7 @@ void zoneBuilderStartInfo(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_START_INFO;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_START_INFO);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1462,7 +1432,7 @@ void zoneBuilderSetPos(PcId_t targetPcId, PositionXYZ *position, zmsg_t *replyMs
     #pragma pack(pop)
 
     PacketType packetType = ZC_SET_POS;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SET_POS);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1483,7 +1453,7 @@ void zoneBuilderGuestPageMap(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_GUESTPAGE_MAP;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_GUESTPAGE_MAP);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1505,7 +1475,7 @@ void zoneBuilderMyPageMap(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_MYPAGE_MAP;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_MYPAGE_MAP);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1527,17 +1497,15 @@ void zoneBuilderHelpList(zmsg_t *replyMsg) {
 
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  47 0D FF FF FF FF 48 00 0C 00 00 00 01 00 00 00 | G.....H.........\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  00 02 00 00 00 00 03 00 00 00 00 04 00 00 00 00 | ................\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  09 00 00 00 00 0A 00 00 00 00 0E 00 00 00 00 0F | ................\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  00 00 00 00 1A 00 00 00 00 1C 00 00 00 00 27 00 | ..............'.\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  00 00 00 28 00 00 00 00                         | ...(....\n"
-          , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x47, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0x48, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+            0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00,
+            0x09, 0x00, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x0F,
+            0x00, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x27, 0x00,
+            0x00, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -1551,7 +1519,7 @@ void zoneBuilderNpcStateList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_NPC_STATE_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_NPC_STATE_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1572,7 +1540,7 @@ void zoneBuilderUiInfoList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_UI_INFO_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_UI_INFO_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1593,7 +1561,7 @@ void zoneBuilderChatMacroList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_CHAT_MACRO_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_CHAT_MACRO_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1613,7 +1581,7 @@ void zoneBuilderAchievePointList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_ACHIEVE_POINT_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ACHIEVE_POINT_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1633,7 +1601,7 @@ void zoneBuilderSkillmapList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_SKILLMAP_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SKILLMAP_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1653,7 +1621,7 @@ void zoneBuilderOptionList(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_OPTION_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_OPTION_LIST);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1672,7 +1640,7 @@ void zoneBuilderMyPCEnter(PositionXYZ *position, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_MYPC_ENTER;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_MYPC_ENTER);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1692,7 +1660,7 @@ void zoneBuilderMoveSpeed(PcId_t targetPcId, float movementSpeed, zmsg_t *replyM
     #pragma pack(pop)
 
     PacketType packetType = ZC_MOVE_SPEED;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_MOVE_SPEED);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1704,7 +1672,7 @@ void zoneBuilderMoveSpeed(PcId_t targetPcId, float movementSpeed, zmsg_t *replyM
     }
 }
 
-void zoneBuilderChat(Commander *commander, uint8_t *chatText, zmsg_t *replyMsg) {
+void zoneBuilderChat(CommanderAppearance *appearance, uint8_t *chatText, zmsg_t *replyMsg) {
 
     size_t chatTextLen = strlen(chatText) + 1;
 
@@ -1723,27 +1691,27 @@ void zoneBuilderChat(Commander *commander, uint8_t *chatText, zmsg_t *replyMsg)
         ItemId_t headTop;
         float displayTime;
         uint8_t chatText[chatTextLen];
-    } replyPacket;
+    } *replyPacket;
     #pragma pack(pop)
 
     PacketType packetType = ZC_CHAT;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, ZC_CHAT);
 
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
     {
-        variableSizePacketHeaderInit(&replyPacket.variableSizeHeader, packetType, sizeof(replyPacket));
-        replyPacket.pcId = commander->pcId;
-        memcpy(replyPacket.familyName, commander->familyName, sizeof(replyPacket.familyName));
-        memcpy(replyPacket.commanderName, commander->commanderName, sizeof(replyPacket.commanderName));
-        replyPacket.unk1 = 0x4F;
-        replyPacket.jobId = commander->jobId;
-        replyPacket.unk2 = 1;
-        replyPacket.gender = commander->gender;
-        replyPacket.hairId = commander->hairId;
-        replyPacket.unk3 = 0;
-        replyPacket.headTop = itemGetId((Item *) commander->inventory.equippedItems[EQSLOT_HAT]);
-        replyPacket.displayTime = 0;
-        memcpy(replyPacket.chatText, chatText, sizeof(replyPacket.chatText));
+        variableSizePacketHeaderInit(&replyPacket->variableSizeHeader, packetType, sizeof(*replyPacket));
+        replyPacket->pcId = appearance->pcId;
+        memcpy(replyPacket->familyName, appearance->familyName, sizeof(replyPacket->familyName));
+        memcpy(replyPacket->commanderName, appearance->commanderName, sizeof(replyPacket->commanderName));
+        replyPacket->unk1 = 0x4F;
+        replyPacket->jobId = appearance->jobId;
+        replyPacket->unk2 = 1;
+        replyPacket->gender = appearance->gender;
+        replyPacket->hairId = appearance->hairId;
+        replyPacket->unk3 = 0;
+        replyPacket->headTop = appearance->headTop;
+        replyPacket->displayTime = 0;
+        memcpy(replyPacket->chatText, chatText, sizeof(replyPacket->chatText));
     }
 }
 
@@ -1759,7 +1727,7 @@ void zoneBuilderJump(PcId_t targetPcId, float height, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_JUMP;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_JUMP);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1808,7 +1776,7 @@ void zoneBuilderConnectOk(
     #pragma pack(pop)
 
     PacketType packetType = ZC_CONNECT_OK;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_CONNECT_OK);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -1851,17 +1819,15 @@ void zoneBuilderSessionObjects(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     // PacketType packetType = ZC_SESSION_OBJECTS;
-    // CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    // CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SESSION_OBJECTS);
     // BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
-        size_t memSize;
-        void *memory = dumpToMem(
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  2B 0C FF FF FF FF 12 00 00 00 00 00 8D FA 02 00 | +...............\n"
-            "[03:07:36][main.c:56 in CNetUsr__PacketHandler_1]  03 00                                           | ..\n"
-            , NULL, &memSize
-        );
+        static const uint8_t packetTemplate[] = {
+            0x2B, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8D, 0xFA, 0x02, 0x00,
+            0x03, 0x00,
+        };
 
-        zmsg_add(replyMsg, zframe_new(memory, memSize));
+        replyWriterAppend(replyMsg, packetTemplate, sizeof(packetTemplate));
     }
 }
 
@@ -1880,58 +1846,85 @@ void zoneBuilderItemInventoryList(Inventory *inventory, zmsg_t *replyMsg) {
         uint8_t properties[attrSize];                         \
     } InventoryItemCPacket;
 
+    bool status = false;
+    size_t reservedSize = 0;
+
     // Get inventory count
     size_t inventoryCount = inventoryGetItemsCount(inventory);
 
     // Calculate size in packet to store all items
-    size_t itemPropertiesSize[ITEM_CAT_COUNT][inventoryCount];
     size_t totalSize = 0;
 
     // Itarate all inventory bags
     for (ItemCategory_t category = 0; category < ITEM_CAT_COUNT; category++) {
 
         // Iterate through all items in this bag
-        Item *item = inventoryGetFirstItem(inventory, category);
-        size_t inventoryIndex = 0;
-
-        while (item) {
-            size_t attrSize = item ? itemGetCPacketSize(item) : 0;
-            itemPropertiesSize[category][inventoryIndex] = attrSize;
+        for (Item *item = inventoryGetFirstItem(inventory, category);
+             item != NULL;
+             item = inventoryGetNextItem(inventory, category))
+        {
+            size_t attrSize = itemGetCPacketSize(item);
 
             #pragma pack(push, 1)
             DEFINE_InventoryItemCPacket(attrSize);
             #pragma pack(pop)
 
             totalSize += sizeof(InventoryItemCPacket);
-
-            item = inventoryGetNextItem(inventory, category);
-            inventoryIndex++;
         }
     }
 
-    // Populate packet for Items
-    uint8_t itemsPacket[totalSize];
+    #pragma pack(push, 1)
+    struct InventoryListPacket {
+        VariableSizePacketHeader variableSizeHeader;
+        uint32_t inventoryCount;
+        Zlib zlibData;
+    } *replyPacket;
+    #pragma pack(pop)
 
-    PacketStream packetStream;
-    packetStreamInit(&packetStream, itemsPacket, sizeof(itemsPacket));
+    PacketType packetType = ZC_ITEM_INVENTORY_LIST;
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, ZC_ITEM_INVENTORY_LIST);
 
-    // Itarate all inventory bags
-    for (ItemCategory_t category = 0; category < ITEM_CAT_COUNT; category++) {
+    // The items are compressed straight into the reply : reserve the biggest compressed packet possible
+    size_t compressedSizeMax = zlibCompressBound(totalSize);
+    reservedSize = sizeof(*replyPacket) - sizeof(replyPacket->zlibData.buffer) + compressedSizeMax;
 
-        // Iterate through all items in this bag
-        size_t inventoryIndex = 0;
+    if (!(replyPacket = replyWriterReserve(replyMsg, reservedSize))) {
+        error("Cannot reserve the inventory list in the reply.");
+        reservedSize = 0;
+        goto cleanup;
+    }
+
+    replyPacket->inventoryCount = inventoryCount;
+
+    ZlibStream zlibStream;
+    if (!(zlibStreamInit(&zlibStream, &replyPacket->zlibData, compressedSizeMax))) {
+        error("Cannot start the compression of the inventory list.");
+        goto cleanup;
+    }
+
+    // Populate packet for Items, chunk by chunk
+    for (ItemCategory_t category = 0; category < ITEM_CAT_COUNT; category++) {
 
         for (Item *item = inventoryGetFirstItem(inventory, category);
              item != NULL;
              item = inventoryGetNextItem(inventory, category))
         {
-            size_t attrSize = itemPropertiesSize[category][inventoryIndex];
+            size_t attrSize = itemGetCPacketSize(item);
 
             #pragma pack(push, 1)
             DEFINE_InventoryItemCPacket(attrSize);
             #pragma pack(pop)
 
-            InventoryItemCPacket *inventoryItemPacket = packetStreamGetCurrentBuffer(&packetStream);
+            // An item bigger than a chunk is serialized apart, then copied in the stream
+            InventoryItemCPacket *inventoryItemPacket;
+            InventoryItemCPacket *bigItemPacket = NULL;
+
+            if (!(inventoryItemPacket = zlibStreamReserve(&zlibStream, sizeof(InventoryItemCPacket)))) {
+                if (!(inventoryItemPacket = bigItemPacket = calloc(1, sizeof(InventoryItemCPacket)))) {
+                    error("Cannot allocate the packet of the item.");
+                    goto cleanup;
+                }
+            }
 
             inventoryItemPacket->itemId = itemGetId(item);
             inventoryItemPacket->sizeOfAttributes = attrSize;
@@ -1942,38 +1935,45 @@ void zoneBuilderItemInventoryList(Inventory *inventory, zmsg_t *replyMsg) {
             inventoryItemPacket->inventoryIndex = inventoryGetBagIndexByActorId(inventory, itemGetCategory(item), actorGetUId(item));
             inventoryItemPacket->unknown2 = 0;
 
-            // fill attribute buffer
-            size_t offset = offsetof(InventoryItemCPacket, properties);
-            packetStreamAddOffset(&packetStream, offset);
-
-            // write in the buffer
+            // write the attributes in the buffer
             if (attrSize > 0) {
+                PacketStream packetStream;
+                packetStreamInit(&packetStream, inventoryItemPacket->properties, attrSize);
                 itemSerializeCPacket(item, &packetStream);
             }
 
-            inventoryIndex++;
+            if (bigItemPacket) {
+                bool written = zlibStreamWrite(&zlibStream, bigItemPacket, sizeof(InventoryItemCPacket));
+                free(bigItemPacket);
+                if (!written) {
+                    error("Cannot compress the packet of the item.");
+                    goto cleanup;
+                }
+            }
         }
     }
 
-    #pragma pack(push, 1)
-    struct InventoryListPacket {
-        VariableSizePacketHeader variableSizeHeader;
-        uint32_t inventoryCount;
-        Zlib zlibData;
-    } replyPacket;
-    #pragma pack(pop)
-
-    PacketType packetType = ZC_ITEM_INVENTORY_LIST;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    // compress content of packet (items)
+    if (!(zlibStreamFinish(&zlibStream))) {
+        error("Cannot compress the inventory list.");
+        goto cleanup;
+    }
 
-    replyPacket.inventoryCount = inventoryCount;
+    size_t outPacketSize = ZLIB_GET_COMPRESSED_PACKET_SIZE(&replyPacket->zlibData, sizeof(*replyPacket));
+    variableSizePacketHeaderInit(&replyPacket->variableSizeHeader, packetType, outPacketSize);
 
-    // compress content of packek (items)
-    zlibCompress(&replyPacket.zlibData, itemsPacket, sizeof(itemsPacket));
-    size_t outPacketSize = ZLIB_GET_COMPRESSED_PACKET_SIZE(&replyPacket.zlibData, sizeof(replyPacket));
-    variableSizePacketHeaderInit(&replyPacket.variableSizeHeader, packetType, outPacketSize);
+    // Give back the space the compression didn't need
+    reservedSize -= outPacketSize;
+    status = true;
 
-    zmsg_add(replyMsg, zframe_new(&replyPacket, outPacketSize));
+cleanup:
+    // On error, the whole packet is removed from the reply
+    if (reservedSize > 0) {
+        replyWriterTrim(replyMsg, reservedSize);
+    }
+    if (!status) {
+        error("Cannot build the inventory list.");
+    }
 }
 
 void zoneBuilderMoveDir(
@@ -2001,22 +2001,22 @@ void zoneBuilderMoveDir(
         uint8_t unk2;
         uint32_t unk3;
         float timestamp;
-    } replyPacket;
+    } *replyPacket;
     #pragma pack(pop)
 
     PacketType packetType = ZC_MOVE_DIR;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, ZC_MOVE_DIR);
 
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
     {
-        serverPacketHeaderInit(&replyPacket.header, packetType);
-        replyPacket.pcId = targetPcId;
-        memcpy(&replyPacket.position, position, sizeof(PositionXYZ));
-        memcpy(&replyPacket.direction, direction, sizeof(PositionXZ));
-        replyPacket.unk1 = 1;
-        replyPacket.unk2 = 0;
-        replyPacket.unk3 = SWAP_UINT32(0x00F04101);
-        replyPacket.timestamp = timestamp;
+        serverPacketHeaderInit(&replyPacket->header, packetType);
+        replyPacket->pcId = targetPcId;
+        memcpy(&replyPacket->position, position, sizeof(PositionXYZ));
+        memcpy(&replyPacket->direction, direction, sizeof(PositionXZ));
+        replyPacket->unk1 = 1;
+        replyPacket->unk2 = 0;
+        replyPacket->unk3 = SWAP_UINT32(0x00F04101);
+        replyPacket->timestamp = timestamp;
     }
 }
 
@@ -2044,20 +2044,20 @@ void zoneBuilderPcMoveStop(
         uint8_t unk1;
         PositionXZ direction;
         float timestamp;
-    } replyPacket;
+    } *replyPacket;
     #pragma pack(pop)
 
     PacketType packetType = ZC_PC_MOVE_STOP;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, ZC_PC_MOVE_STOP);
 
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
     {
-        serverPacketHeaderInit(&replyPacket.header, packetType);
-        replyPacket.pcId = targetPcId;
-        memcpy(&replyPacket.position, position, sizeof(PositionXYZ));
-        memcpy(&replyPacket.direction, direction, sizeof(PositionXZ));
-        replyPacket.unk1 = 1;
-        replyPacket.timestamp = timestamp;
+        serverPacketHeaderInit(&replyPacket->header, packetType);
+        replyPacket->pcId = targetPcId;
+        memcpy(&replyPacket->position, position, sizeof(PositionXYZ));
+        memcpy(&replyPacket->direction, direction, sizeof(PositionXZ));
+        replyPacket->unk1 = 1;
+        replyPacket->timestamp = timestamp;
     }
 }
 
@@ -2072,7 +2072,7 @@ void zoneBuilderRotateHead(PcId_t pcId, PositionXZ *pos, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_HEAD_ROTATE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_HEAD_ROTATE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2091,19 +2091,19 @@ void zoneBuilderRotate(PcId_t pcId, PositionXZ *bodyDir, zmsg_t *replyMsg) {
         PositionXZ bodyDir;
         uint8_t unk3;
         uint8_t unk4;
-    } replyPacket;
+    } *replyPacket;
     #pragma pack(pop)
 
     PacketType packetType = ZC_ROTATE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(*replyPacket, ZC_ROTATE);
 
-    BUILD_REPLY_PACKET(replyPacket, replyMsg)
+    BUILD_REPLY_PACKET_IN_PLACE(replyPacket, replyMsg)
     {
-        serverPacketHeaderInit(&replyPacket.header, packetType);
-        replyPacket.pcId = pcId;
-        replyPacket.bodyDir = *bodyDir;
-        replyPacket.unk3 = false;
-        replyPacket.unk4 = false;
+        serverPacketHeaderInit(&replyPacket->header, packetType);
+        replyPacket->pcId = pcId;
+        replyPacket->bodyDir = *bodyDir;
+        replyPacket->unk3 = false;
+        replyPacket->unk4 = false;
     }
 }
 
@@ -2115,7 +2115,7 @@ void zoneBuilderLogout(zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_LOGOUT_OK;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_LOGOUT_OK);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2136,7 +2136,7 @@ void zoneBuilderPose(PcId_t pcId, CommanderPose_t poseId, PositionXYZ *pos, Posi
     #pragma pack(pop)
 
     PacketType packetType = ZC_POSE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE_WAIVED(replyPacket, ZC_POSE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2162,7 +2162,7 @@ void zoneBuilderChangeCamera(uint8_t mode, PositionXYZ *pos, float fspd, float i
 
     info("Launched changeCamera packet size: %d", sizeof(replyPacket));
     PacketType packetType = ZC_CHANGE_CAMERA;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_CHANGE_CAMERA);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2188,7 +2188,7 @@ void zoneBuilderItemRemove(Item *item, InventoryRemoval removalType, InventoryTy
     #pragma pack(pop)
 
     PacketType packetType = ZC_ITEM_REMOVE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_ITEM_REMOVE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2211,7 +2211,7 @@ void zoneBuilderJobPoints(CommanderJobId_t jobId, CommanderJobPoints_t points, z
     #pragma pack(pop)
 
     PacketType packetType = ZC_JOB_PTS;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_JOB_PTS);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2238,7 +2238,7 @@ void zoneBuilderSkillRangeFan(PcId_t pcId, PositionXYZ *position, PositionXZ *di
     #pragma pack(pop)
 
     PacketType packetType = ZC_SKILL_RANGE_FAN;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SKILL_RANGE_FAN);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2271,7 +2271,7 @@ void zoneBuilderSkillRangeSquare(PcId_t pcId, SkillId_t skillId, PositionXYZ *po
     #pragma pack(pop)
 
     PacketType packetType = ZC_SKILL_RANGE_SQUARE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SKILL_RANGE_SQUARE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2297,7 +2297,7 @@ void zoneBuilderSkillRangeCircle(Skill skill, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_SKILL_RANGE_CIRCLE;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE_WAIVED(replyPacket, ZC_SKILL_RANGE_CIRCLE);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2324,7 +2324,7 @@ void zoneBuilderSkillRangeDbg(Skill skill, zmsg_t *replyMsg) {
     #pragma pack(pop)
 
     PacketType packetType = ZC_SKILL_RANGE_DBG;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE_WAIVED(replyPacket, ZC_SKILL_RANGE_DBG);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2358,7 +2358,7 @@ void zoneBuilderSkillMeleeGround(PcId_t pcId, SkillId_t skillId, PositionXYZ *po
     #pragma pack(pop)
 
     PacketType packetType = ZC_SKILL_MELEE_GROUND;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_SKILL_MELEE_GROUND);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2404,7 +2404,7 @@ void zoneBuilderBuffAdd(PcId_t pcId, Commander *commander, zmsg_t *replyMsg) {
 
 
     PacketType packetType = ZC_BUFF_ADD;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_BUFF_ADD);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -2440,7 +2440,7 @@ void zoneBuilderHealInfo(PcId_t pcId, uint32_t amountHealed, uint32_t maxHP, zms
 
 
     PacketType packetType = ZC_HEAL_INFO;
-    CHECK_SERVER_PACKET_SIZE(replyPacket, packetType);
+    CHECK_SERVER_PACKET_SIZE(replyPacket, ZC_HEAL_INFO);
 
     BUILD_REPLY_PACKET(replyPacket, replyMsg)
     {
@@ -155,7 +155,12 @@ void zoneBuilderBuffList(PcId_t targetPcId, zmsg_t *replyMsg);
 /**
  * @brief Makes a playable character appear in the screen.
  */
-void zoneBuilderEnterPc(Commander *commander, zmsg_t *replyMsg);
+void zoneBuilderEnterPc(CommanderAppearance *appearance, PositionXYZ *position, zmsg_t *replyMsg);
+
+/**
+ * @brief Update the position of a ZC_ENTER_PC packet built beforehand, so it can be sent again as is.
+ */
+void zoneBuilderEnterPcUpdatePosition(uint8_t *enterPcPacket, PositionXYZ *position);
 
 /**
  * @brief Makes a playable character disappear in the screen.
@@ -348,7 +353,7 @@ void zoneBuilderJump(PcId_t targetPcId, float height, zmsg_t *replyMsg);
 /**
  * Makes a normal chat message
  */
-void zoneBuilderChat(Commander *commander, uint8_t *chatText, zmsg_t *replyMsg);
+void zoneBuilderChat(CommanderAppearance *appearance, uint8_t *chatText, zmsg_t *replyMsg);
 
 /**
  * @brief @unknown Contains information about quest position?
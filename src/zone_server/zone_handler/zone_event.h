@@ -20,15 +20,20 @@
 
 // ---------- Includes ------------
 #include "R1EMU.h"
+#include "common/commander/commander.h"
 
 // ---------- Defines -------------
 
 
 // ------ Structure declaration -------
-/** Event data needed for a commander to update position */
+/**
+ * Event data needed for a commander to update position.
+ * The events only carry IDs and positions : the appearance of the commander is sent once
+ * with GameEventEnterPc, and the EventServer keeps it for the other events.
+ */
 typedef struct {
     MapId_t mapId;
-    Commander commander;
+    PcId_t pcId;
     PositionXYZ newPosition;
 } GameEventUpdatePosition;
 
@@ -62,17 +67,18 @@ typedef struct {
 /** Event data needed for make a commander enter in the zone */
 typedef struct {
     GameEventUpdatePosition updatePosEvent;
+    CommanderAppearance appearance;
 } GameEventEnterPc;
 
 /** Event data needed for a commander to chat */
 #define DECLARE_GameEventChat(chatTextSize) \
 typedef struct { \
-    Commander commander; \
+    PcId_t pcId; \
     uint8_t chatText[chatTextSize]; \
 } GameEventChat;
 #define CHAT_TEXT_SIZE_MAX 500
 typedef struct {
-    Commander commander;
+    PcId_t pcId;
     uint8_t chatText[CHAT_TEXT_SIZE_MAX];
 } _GameEventChat;
 
@@ -93,6 +99,18 @@ typedef struct {
     PcId_t pcId;
 } GameEventLeave;
 
+/** Event data needed to hand off a commander to the EventServer shard of another map */
+typedef struct {
+    PcId_t pcId;
+    MapId_t toMapId;
+} GameEventWarp;
+
+/** Event data needed to refresh the appearance of a commander kept by the EventServer (equipment, stance, name) */
+typedef struct {
+    PcId_t pcId;
+    CommanderAppearance appearance;
+} GameEventAppearanceChange;
+
 /** Event data needed for a commander to stop moving */
 typedef struct {
     PcId_t pcId;
@@ -112,6 +130,8 @@ typedef union {
     GameEventHeadRotate headRotate;
     GameEventRotate rotate;
     GameEventLeave leave;
+    GameEventWarp warp;
+    GameEventAppearanceChange appearanceChange;
     GameEventPose pose;
 } ZoneEvent;
 
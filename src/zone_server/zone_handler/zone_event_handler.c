@@ -28,6 +28,8 @@ static bool zoneEventHandlerHeadRotate(EventServer *self, GameEvent *event);
 static bool zoneEventHandlerRotate(EventServer *self, GameEvent *event);
 static bool zoneEventHandlerLeave(EventServer *self, GameEvent *event);
 static bool zoneEventHandlerPose(EventServer *self, GameEvent *event);
+static bool zoneEventHandlerWarp(EventServer *self, GameEvent *event);
+static bool zoneEventHandlerAppearanceChange(EventServer *self, GameEvent *event);
 
 /**
  * @brief zoneEventHandlers is a global table containing all the zone event handlers.
@@ -46,6 +48,8 @@ const EventHandler zoneEventHandlers[EVENT_TYPE_ZONE_END] = {
     REGISTER_PACKET_HANDLER(EVENT_TYPE_ROTATE, zoneEventHandlerRotate),
     REGISTER_PACKET_HANDLER(EVENT_TYPE_LEAVE, zoneEventHandlerLeave),
     REGISTER_PACKET_HANDLER(EVENT_TYPE_POSE, zoneEventHandlerPose),
+    REGISTER_PACKET_HANDLER(EVENT_TYPE_WARP, zoneEventHandlerWarp),
+    REGISTER_PACKET_HANDLER(EVENT_TYPE_APPEARANCE_CHANGE, zoneEventHandlerAppearanceChange),
 
     #undef REGISTER_PACKET_HANDLER
 };
@@ -53,9 +57,18 @@ const EventHandler zoneEventHandlers[EVENT_TYPE_ZONE_END] = {
 bool zoneEventHandlerEnterPc(EventServer *self, GameEvent *event) {
 
     bool status = true;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     GameEventEnterPc *enterPcEvent = &event->data.zone.enterPc;
 
+    // keep the appearance of the client for its next events
+    if (!(zoneEventServerSetClientAppearance(self, event->emitterSk,
+        &enterPcEvent->appearance, &enterPcEvent->updatePosEvent.newPosition)))
+    {
+        error("Cannot keep the appearance of %s.", event->emitterSk);
+        status = false;
+        goto cleanup;
+    }
+
     // update client position
     if (!(zoneEventServerUpdateClientPosition(self, event, &enterPcEvent->updatePosEvent, &clientsAround))) {
         error("Cannot update player %s position.", event->emitterSk);
@@ -64,14 +77,13 @@ bool zoneEventHandlerEnterPc(EventServer *self, GameEvent *event) {
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     return status;
 }
 
 bool zoneEventHandlerCommanderMove(EventServer *self, GameEvent *event) {
 
     bool status = true;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     zmsg_t *msg = NULL;
     GameEventCommanderMove *moveEvent = &event->data.zone.move;
 
@@ -82,28 +94,25 @@ bool zoneEventHandlerCommanderMove(EventServer *self, GameEvent *event) {
         goto cleanup;
     }
 
-    if (zlist_size(clientsAround) > 0) {
-        // build the packet for the clients around
-        msg = zmsg_new();
-
-        zoneBuilderMoveDir(
-            moveEvent->updatePosEvent.commander.pcId,
-            &moveEvent->position,
-            &moveEvent->direction,
-            moveEvent->timestamp,
-            msg
-        );
-
-        // send the packet
-        if (!(eventServerSendToClients(self, clientsAround, msg))) {
-            error("Failed to send the packet to the clients.");
-            status = false;
-            goto cleanup;
-        }
+    // build the movement state, sent to the clients around at the end of the tick
+    msg = zmsg_new();
+
+    zoneBuilderMoveDir(
+        moveEvent->updatePosEvent.pcId,
+        &moveEvent->position,
+        &moveEvent->direction,
+        moveEvent->timestamp,
+        msg
+    );
+
+    zframe_t *moveFrame = zmsg_first(msg);
+    if (!(eventServerQueueTickUpdate(self, event->emitterSk, EVENT_SERVER_TICK_SLOT_MOVE, zframe_data(moveFrame), zframe_size(moveFrame)))) {
+        error("Failed to queue the movement of %s.", event->emitterSk);
+        status = false;
+        goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -112,7 +121,7 @@ bool zoneEventHandlerMoveStop(EventServer *self, GameEvent *event) {
 
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     GameEventMoveStop *moveStopEvent = &event->data.zone.moveStop;
 
     // update client position and get the clients around
@@ -122,28 +131,25 @@ bool zoneEventHandlerMoveStop(EventServer *self, GameEvent *event) {
         goto cleanup;
     }
 
-    if (zlist_size(clientsAround) > 0) {
-        // build the packet for the clients around
-        msg = zmsg_new();
-
-        zoneBuilderPcMoveStop(
-            moveStopEvent->updatePosEvent.commander.pcId,
-            &moveStopEvent->position,
-            &moveStopEvent->direction,
-            moveStopEvent->timestamp,
-            msg
-        );
-
-        // send the packet
-        if (!(eventServerSendToClients(self, clientsAround, msg))) {
-            error("Failed to send the packet to the clients.");
-            status = false;
-            goto cleanup;
-        }
+    // build the movement state, replacing the movement of the current tick
+    msg = zmsg_new();
+
+    zoneBuilderPcMoveStop(
+        moveStopEvent->updatePosEvent.pcId,
+        &moveStopEvent->position,
+        &moveStopEvent->direction,
+        moveStopEvent->timestamp,
+        msg
+    );
+
+    zframe_t *moveStopFrame = zmsg_first(msg);
+    if (!(eventServerQueueTickUpdate(self, event->emitterSk, EVENT_SERVER_TICK_SLOT_MOVE, zframe_data(moveStopFrame), zframe_size(moveStopFrame)))) {
+        error("Failed to queue the movement stop of %s.", event->emitterSk);
+        status = false;
+        goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -153,7 +159,7 @@ bool zoneEventHandlerJump(EventServer *self, GameEvent *event) {
 
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     GameEventJump *jumpEvent = &event->data.zone.jump;
 
     // update client position and get the clients around
@@ -163,23 +169,26 @@ bool zoneEventHandlerJump(EventServer *self, GameEvent *event) {
         goto cleanup;
     }
 
-    // add itself in the clients list
-    zlist_append(clientsAround, event->emitterSk);
-
     // build the packet for the clients around
     msg = zmsg_new();
 
-    zoneBuilderJump(jumpEvent->updatePosEvent.commander.pcId, jumpEvent->height, msg);
+    zoneBuilderJump(jumpEvent->updatePosEvent.pcId, jumpEvent->height, msg);
+
+    // the client sees itself jumping too
+    if (!eventServerGetClientIdsAround(self, event->emitterSk, EVENT_SERVER_LOD_FAR, true, &clientsAround)) {
+        error("Cannot get clients within range");
+        status = false;
+        goto cleanup;
+    }
 
     // send the packet
-    if (!(eventServerSendToClients(self, clientsAround, msg))) {
+    if (!(eventServerSendToClients(self, clientsAround->ids, clientsAround->count, msg))) {
         error("Failed to send the packet to the clients.");
         status = false;
         goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -187,37 +196,41 @@ cleanup:
 bool zoneEventHandlerChat(EventServer *self, GameEvent *event) {
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     _GameEventChat *chatEvent = &event->data.zone.chat;
+    ZoneClientAppearance *clientAppearance;
+
+    // get the appearance of the emitter
+    if (!(clientAppearance = zoneEventServerGetClientAppearance(self, event->emitterSk))) {
+        error("Cannot get the appearance of %s.", event->emitterSk);
+        status = false;
+        goto cleanup;
+    }
 
     // get the clients around
-    if (!eventServerGetClientsAround(self, event->emitterSk, &clientsAround)) {
+    if (!eventServerGetClientIdsAround(self, event->emitterSk, EVENT_SERVER_LOD_FAR, true, &clientsAround)) {
         error("Cannot get clients within range");
         status = false;
         goto cleanup;
     }
 
-    // add itself in the clients list
-    zlist_append(clientsAround, event->emitterSk);
-
     // build the packet for the clients around
     msg = zmsg_new();
 
     zoneBuilderChat(
-        &chatEvent->commander,
+        &clientAppearance->appearance,
         chatEvent->chatText,
         msg
     );
 
     // send the packet
-    if (!(eventServerSendToClients(self, clientsAround, msg))) {
+    if (!(eventServerSendToClients(self, clientsAround->ids, clientsAround->count, msg))) {
         error("Failed to send the packet to the clients.");
         status = false;
         goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -225,19 +238,16 @@ cleanup:
 bool zoneEventHandlerRestSit(EventServer *self, GameEvent *event) {
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     GameEventRestSit *restSitEvent = &event->data.zone.restSit;
 
     // Get the clients around
-    if (!eventServerGetClientsAround(self, event->emitterSk, &clientsAround)) {
+    if (!eventServerGetClientIdsAround(self, event->emitterSk, EVENT_SERVER_LOD_FAR, true, &clientsAround)) {
         error("Cannot get clients within range");
         status = false;
         goto cleanup;
     }
 
-    // add itself in the clients list
-    zlist_append(clientsAround, event->emitterSk);
-
     // build the packet for the clients around
     msg = zmsg_new();
 
@@ -247,14 +257,13 @@ bool zoneEventHandlerRestSit(EventServer *self, GameEvent *event) {
     );
 
     // send the packet
-    if (!(eventServerSendToClients(self, clientsAround, msg))) {
+    if (!(eventServerSendToClients(self, clientsAround->ids, clientsAround->count, msg))) {
         error("Failed to send the packet to the clients.");
         status = false;
         goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -262,20 +271,9 @@ cleanup:
 bool zoneEventHandlerHeadRotate(EventServer *self, GameEvent *event) {
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
     GameEventHeadRotate *headRotateEvent = &event->data.zone.headRotate;
 
-    // Get the clients around
-    if (!eventServerGetClientsAround(self, event->emitterSk, &clientsAround)) {
-        error("Cannot get clients within range");
-        status = false;
-        goto cleanup;
-    }
-
-    // add itself in the clients list
-    zlist_append(clientsAround, event->emitterSk);
-
-    // build the packet for the clients around
+    // build the head direction, sent to the clients around at the end of the tick
     msg = zmsg_new();
 
     zoneBuilderRotateHead(
@@ -284,15 +282,14 @@ bool zoneEventHandlerHeadRotate(EventServer *self, GameEvent *event) {
         msg
     );
 
-    // send the packet
-    if (!(eventServerSendToClients(self, clientsAround, msg))) {
-        error("Failed to send the packet to the clients.");
+    zframe_t *headRotateFrame = zmsg_first(msg);
+    if (!(eventServerQueueTickUpdate(self, event->emitterSk, EVENT_SERVER_TICK_SLOT_HEAD_ROTATE, zframe_data(headRotateFrame), zframe_size(headRotateFrame)))) {
+        error("Failed to queue the head rotation of %s.", event->emitterSk);
         status = false;
         goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -300,20 +297,9 @@ cleanup:
 bool zoneEventHandlerRotate(EventServer *self, GameEvent *event) {
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
     GameEventRotate *rotateEvent = &event->data.zone.rotate;
 
-    // Get the clients around
-    if (!eventServerGetClientsAround(self, event->emitterSk, &clientsAround)) {
-        error("Cannot get clients within range");
-        status = false;
-        goto cleanup;
-    }
-
-    // add itself in the clients list
-    zlist_append(clientsAround, event->emitterSk);
-
-    // build the packet for the clients around
+    // build the direction, sent to the clients around at the end of the tick
     msg = zmsg_new();
 
     zoneBuilderRotate(
@@ -322,15 +308,14 @@ bool zoneEventHandlerRotate(EventServer *self, GameEvent *event) {
         msg
     );
 
-    // send the packet
-    if (!(eventServerSendToClients(self, clientsAround, msg))) {
-        error("Failed to send the packet to the clients.");
+    zframe_t *rotateFrame = zmsg_first(msg);
+    if (!(eventServerQueueTickUpdate(self, event->emitterSk, EVENT_SERVER_TICK_SLOT_ROTATE, zframe_data(rotateFrame), zframe_size(rotateFrame)))) {
+        error("Failed to queue the rotation of %s.", event->emitterSk);
         status = false;
         goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -338,22 +323,16 @@ cleanup:
 bool zoneEventHandlerLeave(EventServer *self, GameEvent *event) {
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     GameEventLeave *leaveEvent = &event->data.zone.leave;
 
     // Get the clients around
-    if (!eventServerGetClientsAround(self, event->emitterSk, &clientsAround)) {
+    if (!eventServerGetClientIdsAround(self, event->emitterSk, EVENT_SERVER_LOD_FAR, true, &clientsAround)) {
         error("Cannot get clients within range");
         status = false;
         goto cleanup;
     }
 
-    // add itself in the clients list
-    zlist_append(clientsAround, event->emitterSk);
-
-    // Remove the node from the proximity graph
-    eventServerRemoveClient(self, event->emitterSk);
-
     // build the packet for the clients around
     msg = zmsg_new();
 
@@ -362,15 +341,16 @@ bool zoneEventHandlerLeave(EventServer *self, GameEvent *event) {
         msg
     );
 
-    // send the packet
-    if (!(eventServerSendToClients(self, clientsAround, msg))) {
+    // send the packet, while the client still has its compact ID
+    if (!(eventServerSendToClients(self, clientsAround->ids, clientsAround->count, msg))) {
         error("Failed to send the packet to the clients.");
         status = false;
-        goto cleanup;
     }
 
+    // Remove the node from the proximity graph
+    eventServerRemoveClient(self, event->emitterSk);
+
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
@@ -378,19 +358,34 @@ cleanup:
 bool zoneEventHandlerPose(EventServer *self, GameEvent *event) {
     bool status = true;
     zmsg_t *msg = NULL;
-    zlist_t *clientsAround = NULL;
+    NeighborSet *clientsAround = NULL;
     GameEventPose *poseEvent = &event->data.zone.pose;
+    ZoneClientAppearance *clientAppearance;
+
+    // The stance is a part of the appearance : rebuild the ZC_ENTER_PC kept for the client
+    if (!(clientAppearance = zoneEventServerGetClientAppearance(self, event->emitterSk))) {
+        error("Cannot get the appearance of %s.", event->emitterSk);
+        status = false;
+        goto cleanup;
+    }
+
+    if (clientAppearance->appearance.pose != poseEvent->poseId) {
+        CommanderAppearance appearance = clientAppearance->appearance;
+        appearance.pose = poseEvent->poseId;
+        if (!(zoneEventServerSetClientAppearance(self, event->emitterSk, &appearance, &poseEvent->position))) {
+            error("Cannot update the appearance of %s.", event->emitterSk);
+            status = false;
+            goto cleanup;
+        }
+    }
 
     // Get the clients around
-    if (!eventServerGetClientsAround(self, event->emitterSk, &clientsAround)) {
+    if (!eventServerGetClientIdsAround(self, event->emitterSk, EVENT_SERVER_LOD_FAR, true, &clientsAround)) {
         error("Cannot get clients within range");
         status = false;
         goto cleanup;
     }
 
-    // add itself in the clients list
-    zlist_append(clientsAround, event->emitterSk);
-
     // build the packet for the clients around
     msg = zmsg_new();
 
@@ -403,14 +398,65 @@ bool zoneEventHandlerPose(EventServer *self, GameEvent *event) {
     );
 
     // send the packet
-    if (!(eventServerSendToClients(self, clientsAround, msg))) {
+    if (!(eventServerSendToClients(self, clientsAround->ids, clientsAround->count, msg))) {
+        error("Failed to send the packet to the clients.");
+        status = false;
+        goto cleanup;
+    }
+
+cleanup:
+    zmsg_destroy(&msg);
+    return status;
+}
+
+bool zoneEventHandlerWarp(EventServer *self, GameEvent *event) {
+    bool status = true;
+    zmsg_t *msg = NULL;
+    NeighborSet *clientsAround = NULL;
+    GameEventWarp *warpEvent = &event->data.zone.warp;
+
+    // Get the clients around, on the previous map
+    if (!eventServerGetClientIdsAround(self, event->emitterSk, EVENT_SERVER_LOD_FAR, false, &clientsAround)) {
+        error("Cannot get clients within range");
+        status = false;
+        goto cleanup;
+    }
+
+    // The shard of the new map owns the client from now on
+    eventServerRemoveClient(self, event->emitterSk);
+    dbg("Client %s handed off to the map %x.", event->emitterSk, warpEvent->toMapId);
+
+    // The client is still connected : only the clients around see it leaving
+    msg = zmsg_new();
+    zoneBuilderLeave(warpEvent->pcId, msg);
+
+    if (!(eventServerSendToClients(self, clientsAround->ids, clientsAround->count, msg))) {
         error("Failed to send the packet to the clients.");
         status = false;
         goto cleanup;
     }
 
 cleanup:
-    zlist_destroy(&clientsAround);
     zmsg_destroy(&msg);
     return status;
 }
+
+bool zoneEventHandlerAppearanceChange(EventServer *self, GameEvent *event) {
+    GameEventAppearanceChange *appearanceEvent = &event->data.zone.appearanceChange;
+    ZoneClientAppearance *clientAppearance;
+    PositionXYZ position;
+
+    // Only the appearance changed : keep the client at its position
+    if (!(clientAppearance = zoneEventServerGetClientAppearance(self, event->emitterSk))) {
+        error("Cannot get the appearance of %s.", event->emitterSk);
+        return false;
+    }
+    position = clientAppearance->position;
+
+    if (!(zoneEventServerSetClientAppearance(self, event->emitterSk, &appearanceEvent->appearance, &position))) {
+        error("Cannot update the appearance of %s.", event->emitterSk);
+        return false;
+    }
+
+    return true;
+}
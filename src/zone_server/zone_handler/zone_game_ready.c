@@ -0,0 +1,235 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+// ---------- Includes ------------
+#include "zone_game_ready.h"
+#include "zone_builder.h"
+#include "common/packet/reply_writer.h"
+
+// ------ Structure declaration -------
+/**
+ * @brief ZoneGameReadyStep builds one part of the GAME_READY reply.
+ *        Only one of the builders is set.
+ */
+typedef struct {
+    // builder of packets identical for every commander, built once in the blob
+    void (*sharedBuilder)(zmsg_t *replyMsg);
+
+    // builder of packets depending on the commander, built for each reply
+    void (*commanderBuilder)(Commander *commander, zmsg_t *replyMsg);
+} ZoneGameReadyStep;
+
+/**
+ * @brief ZoneGameReadySegment locates a shared packet in the blob
+ */
+typedef struct {
+    size_t offset;
+    size_t size;
+} ZoneGameReadySegment;
+
+// ------ Static declaration -------
+static void zoneGameReadyStartGame(zmsg_t *replyMsg);
+static void zoneGameReadyItemEquipList(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyItemInventoryList(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadySkillList(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyAbilityList(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyCooldownList(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyNormalUnk4(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyObjectProperty(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyLoginTime(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyMyPCEnter(Commander *commander, zmsg_t *replyMsg);
+static void zoneGameReadyMoveSpeed(Commander *commander, zmsg_t *replyMsg);
+
+/**
+ * @brief Packets of the GAME_READY reply, in the order expected by the client
+ */
+static const ZoneGameReadyStep zoneGameReadySteps[] = {
+    {.sharedBuilder = zoneBuilderSessionObjects},
+    {.sharedBuilder = zoneBuilderOptionList},
+    {.sharedBuilder = zoneBuilderSkillmapList},
+    {.sharedBuilder = zoneBuilderAchievePointList},
+    {.sharedBuilder = zoneBuilderChatMacroList},
+    {.sharedBuilder = zoneBuilderUiInfoList},
+    {.sharedBuilder = zoneBuilderNpcStateList},
+
+    {.sharedBuilder = zoneBuilderHelpList},
+    {.sharedBuilder = zoneBuilderMyPageMap},
+    {.sharedBuilder = zoneBuilderGuestPageMap},
+    {.sharedBuilder = zoneBuilderStartInfo},
+
+    {.commanderBuilder = zoneGameReadyItemEquipList},
+    {.commanderBuilder = zoneGameReadyItemInventoryList},
+
+    {.commanderBuilder = zoneGameReadySkillList},
+    {.commanderBuilder = zoneGameReadyAbilityList},
+    {.commanderBuilder = zoneGameReadyCooldownList},
+
+    {.sharedBuilder = zoneBuilderQuickSlotList},
+
+    {.sharedBuilder = zoneBuilderNormalUnk1},
+    {.sharedBuilder = zoneBuilderNormalUnk2},
+    {.sharedBuilder = zoneBuilderNormalUnk3},
+    {.commanderBuilder = zoneGameReadyNormalUnk4},
+    {.sharedBuilder = zoneBuilderNormalUnk5},
+
+    {.sharedBuilder = zoneGameReadyStartGame},
+    {.commanderBuilder = zoneGameReadyObjectProperty},
+    // zoneBuilderStamina
+    {.commanderBuilder = zoneGameReadyLoginTime},
+
+    {.commanderBuilder = zoneGameReadyMyPCEnter},
+    // zoneBuilderSkillAdd
+    // zoneBuilderBuffList
+
+    // add NPC at the start screen
+    {.sharedBuilder = zoneBuilderEnterMonster},
+    {.sharedBuilder = zoneBuilderFaction},
+
+    {.commanderBuilder = zoneGameReadyMoveSpeed},
+};
+
+#define ZONE_GAME_READY_STEPS_COUNT (sizeof(zoneGameReadySteps) / sizeof(*zoneGameReadySteps))
+
+/** Shared packets, one after the other */
+static uint8_t *zoneGameReadyBlob = NULL;
+
+/** Shared packets of each step, in the blob */
+static ZoneGameReadySegment *zoneGameReadySegments = NULL;
+static size_t zoneGameReadyFirstSegment[ZONE_GAME_READY_STEPS_COUNT];
+static size_t zoneGameReadySegmentsCount[ZONE_GAME_READY_STEPS_COUNT];
+
+
+// ------ Extern function implementation -------
+
+bool zoneGameReadyInit(void) {
+
+    bool status = false;
+    zmsg_t *sharedMsg = NULL;
+    size_t blobSize = 0;
+    size_t segmentsCount = 0;
+
+    // Build all the shared packets once
+    if (!(sharedMsg = zmsg_new())) {
+        error("Cannot allocate the shared packets message.");
+        goto cleanup;
+    }
+
+    for (size_t step = 0; step < ZONE_GAME_READY_STEPS_COUNT; step++) {
+        zoneGameReadyFirstSegment[step] = zmsg_size(sharedMsg);
+        if (zoneGameReadySteps[step].sharedBuilder) {
+            zoneGameReadySteps[step].sharedBuilder(sharedMsg);
+        }
+        zoneGameReadySegmentsCount[step] = zmsg_size(sharedMsg) - zoneGameReadyFirstSegment[step];
+    }
+
+    // Pack them in the blob, and keep their boundaries : a reply without ReplyWriter needs a frame per packet
+    segmentsCount = zmsg_size(sharedMsg);
+    blobSize = zmsg_content_size(sharedMsg);
+
+    if (!(zoneGameReadyBlob = malloc(blobSize))
+    ||  !(zoneGameReadySegments = malloc(sizeof(ZoneGameReadySegment) * segmentsCount))) {
+        error("Cannot allocate the shared packets blob.");
+        goto cleanup;
+    }
+
+    size_t offset = 0;
+    size_t segment = 0;
+    for (zframe_t *frame = zmsg_first(sharedMsg); frame != NULL; frame = zmsg_next(sharedMsg)) {
+        memcpy(&zoneGameReadyBlob[offset], zframe_data(frame), zframe_size(frame));
+        zoneGameReadySegments[segment].offset = offset;
+        zoneGameReadySegments[segment].size = zframe_size(frame);
+        offset += zframe_size(frame);
+        segment++;
+    }
+
+    info("GAME_READY reply : %d shared packets built once (%d bytes).", segmentsCount, blobSize);
+    status = true;
+
+cleanup:
+    if (!status) {
+        zoneGameReadyFree();
+    }
+    zmsg_destroy(&sharedMsg);
+    return status;
+}
+
+void zoneGameReadyBuildReply(Commander *commander, zmsg_t *replyMsg) {
+
+    for (size_t step = 0; step < ZONE_GAME_READY_STEPS_COUNT; step++) {
+
+        if (zoneGameReadySteps[step].commanderBuilder) {
+            zoneGameReadySteps[step].commanderBuilder(commander, replyMsg);
+            continue;
+        }
+
+        // Splice the shared packets of the step from the blob
+        ZoneGameReadySegment *segments = &zoneGameReadySegments[zoneGameReadyFirstSegment[step]];
+        for (size_t i = 0; i < zoneGameReadySegmentsCount[step]; i++) {
+            replyWriterAppend(replyMsg, &zoneGameReadyBlob[segments[i].offset], segments[i].size);
+        }
+    }
+}
+
+void zoneGameReadyFree(void) {
+    free(zoneGameReadyBlob);
+    zoneGameReadyBlob = NULL;
+    free(zoneGameReadySegments);
+    zoneGameReadySegments = NULL;
+}
+
+// ------ Static function implementation -------
+
+static void zoneGameReadyStartGame(zmsg_t *replyMsg) {
+    zoneBuilderStartGame(1.0, 0.0, 0.0, 0.0, replyMsg);
+}
+
+static void zoneGameReadyItemEquipList(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderItemEquipList(&commander->inventory, replyMsg);
+}
+
+static void zoneGameReadyItemInventoryList(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderItemInventoryList(&commander->inventory, replyMsg);
+}
+
+static void zoneGameReadySkillList(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderSkillList(commander->pcId, replyMsg);
+}
+
+static void zoneGameReadyAbilityList(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderAbilityList(commander->pcId, replyMsg);
+}
+
+static void zoneGameReadyCooldownList(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderCooldownList(commander->socialInfoId, replyMsg);
+}
+
+static void zoneGameReadyNormalUnk4(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderNormalUnk4(commander->socialInfoId, replyMsg);
+}
+
+static void zoneGameReadyObjectProperty(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderObjectProperty(commander->socialInfoId, replyMsg);
+}
+
+static void zoneGameReadyLoginTime(Commander *commander, zmsg_t *replyMsg) {
+    // The login time is the current time
+    zoneBuilderLoginTime(replyMsg);
+}
+
+static void zoneGameReadyMyPCEnter(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderMyPCEnter(&commander->pos, replyMsg);
+}
+
+static void zoneGameReadyMoveSpeed(Commander *commander, zmsg_t *replyMsg) {
+    zoneBuilderMoveSpeed(commander->pcId, 31.0f, replyMsg);
+}
@@ -0,0 +1,45 @@
+/**
+ *
+ *   ██████╗   ██╗ ███████╗ ███╗   ███╗ ██╗   ██╗
+ *   ██╔══██╗ ███║ ██╔════╝ ████╗ ████║ ██║   ██║
+ *   ██████╔╝ ╚██║ █████╗   ██╔████╔██║ ██║   ██║
+ *   ██╔══██╗  ██║ ██╔══╝   ██║╚██╔╝██║ ██║   ██║
+ *   ██║  ██║  ██║ ███████╗ ██║ ╚═╝ ██║ ╚██████╔╝
+ *   ╚═╝  ╚═╝  ╚═╝ ╚══════╝ ╚═╝     ╚═╝  ╚═════╝
+ *
+ * @file zone_game_ready.h
+ * @brief Reply to CZ_GAME_READY, sent to each commander entering the zone.
+ *
+ * Most of the packets of the reply are the same for every commander : they are built once when the server starts,
+ * one after the other in a single blob. The reply of a commander copies them from the blob,
+ * and only builds the packets depending on the commander in between.
+ *
+ * @license GNU GENERAL PUBLIC LICENSE - Version 2, June 1991
+ *          See LICENSE file for further information
+ */
+
+#pragma once
+
+// ---------- Includes ------------
+#include "R1EMU.h"
+#include "common/commander/commander.h"
+
+// ----------- Functions ------------
+/**
+ * @brief Build the packets of the GAME_READY reply shared by every commander.
+ *        It must be called before the workers start.
+ * @return true on success, false otherwise
+ */
+bool zoneGameReadyInit(void);
+
+/**
+ * @brief Add the packets of the GAME_READY reply of a commander to a message
+ * @param commander The commander entering the zone
+ * @param replyMsg The reply message
+ */
+void zoneGameReadyBuildReply(Commander *commander, zmsg_t *replyMsg);
+
+/**
+ * @brief Free the packets shared by every commander
+ */
+void zoneGameReadyFree(void);
@@ -15,6 +15,8 @@
 #include "zone_builder.h"
 #include "zone_event_handler.h"
 #include "admin_cmd.h"
+#include "zone_game_ready.h"
+#include "zone_server/zone_event_server.h"
 #include "common/packet/packet.h"
 #include "common/redis/fields/redis_game_session.h"
 #include "common/redis/fields/redis_socket_session.h"
@@ -159,9 +161,9 @@ static PacketHandlerState zoneHandlerChat(
     // normal message : Dispatch a GameEventChat
     DECLARE_GameEventChat(msgSize);
     GameEventChat event;
-    memcpy(&event.commander, session->game.commanderSession.currentCommander, sizeof(event.commander));
+    event.pcId = session->game.commanderSession.currentCommander->pcId;
     memcpy(event.chatText, clientPacket->msgText, msgSize);
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_CHAT, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_CHAT, &event, sizeof(event));
 
 
     return PACKET_HANDLER_UPDATE_SESSION;
@@ -186,7 +188,7 @@ static PacketHandlerState zoneHandlerRestSit(
     GameEventRestSit event = {
         .pcId = session->game.commanderSession.currentCommander->pcId,
     };
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_REST_SIT, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_REST_SIT, &event, sizeof(event));
 
     return PACKET_HANDLER_OK;
 }
@@ -225,7 +227,7 @@ static PacketHandlerState zoneHandlerSkillGround(
     special("Current pos : ");
     positionXYZDump(&session->game.commanderSession.currentCommander->pos);
 
-    CHECK_CLIENT_PACKET_SIZE(*clientPacket, packetSize, CZ_SKILL_GROUND);
+    CHECK_CLIENT_PACKET_SIZE_WAIVED(*clientPacket, packetSize, CZ_SKILL_GROUND);
 
     /*   CzSkillGroundPacket :
          u1 skillId  unk2     x        y        z        x2       y2       z2       u3       u4       u5       u6 u7
@@ -375,7 +377,7 @@ static PacketHandlerState zoneHandlerLogout(
     GameEventLeave event = {
         .pcId = session->game.commanderSession.currentCommander->pcId,
     };
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_LEAVE, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_LEAVE, &event, sizeof(event));
 
     return PACKET_HANDLER_OK;
 }
@@ -426,14 +428,15 @@ static PacketHandlerState zoneHandlerMoveStop(
     GameEventMoveStop event = {
         .updatePosEvent = {
             .mapId = session->socket.mapId,
-            .commander = *session->game.commanderSession.currentCommander,
+            .pcId = session->game.commanderSession.currentCommander->pcId,
+            .newPosition = clientPacket->position
         },
         .position = clientPacket->position,
         .direction = clientPacket->direction,
         .timestamp = clientPacket->timestamp,
     };
 
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_MOVE_STOP, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_MOVE_STOP, &event, sizeof(event));
 
     return PACKET_HANDLER_OK;
 }
@@ -476,14 +479,15 @@ static PacketHandlerState zoneHandlerKeyboardMove(
     GameEventCommanderMove event = {
         .updatePosEvent = {
             .mapId = session->socket.mapId,
-            .commander = *session->game.commanderSession.currentCommander
+            .pcId = session->game.commanderSession.currentCommander->pcId,
+            .newPosition = clientPacket->position
         },
         .position = clientPacket->position,
         .direction = clientPacket->direction,
         .timestamp = clientPacket->timestamp,
     };
 
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_COMMANDER_MOVE, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_COMMANDER_MOVE, &event, sizeof(event));
 
     return PACKET_HANDLER_UPDATE_SESSION;
 }
@@ -522,59 +526,21 @@ static PacketHandlerState zoneHandlerGameReady(
     // CHECK_CLIENT_PACKET_SIZE(*clientPacket, packetSize, CZ_GAME_READY);
     Commander *commander = session->game.commanderSession.currentCommander;
 
-    zoneBuilderSessionObjects(replyMsg);
-    zoneBuilderOptionList(replyMsg);
-    zoneBuilderSkillmapList(replyMsg);
-    zoneBuilderAchievePointList(replyMsg);
-    zoneBuilderChatMacroList(replyMsg);
-    zoneBuilderUiInfoList(replyMsg);
-    zoneBuilderNpcStateList(replyMsg);
-
-    zoneBuilderHelpList(replyMsg);
-    zoneBuilderMyPageMap(replyMsg);
-    zoneBuilderGuestPageMap(replyMsg);
-    zoneBuilderStartInfo(replyMsg);
-
-    Inventory *inventory = &session->game.commanderSession.currentCommander->inventory;
-    zoneBuilderItemEquipList(inventory, replyMsg);
-    zoneBuilderItemInventoryList(inventory, replyMsg);
-
-    zoneBuilderSkillList(commander->pcId, replyMsg);
-    zoneBuilderAbilityList(commander->pcId, replyMsg);
-    zoneBuilderCooldownList(commander->socialInfoId, replyMsg);
-
-    zoneBuilderQuickSlotList(replyMsg);
-
-    zoneBuilderNormalUnk1(replyMsg);
-    zoneBuilderNormalUnk2(replyMsg);
-    zoneBuilderNormalUnk3(replyMsg);
-    zoneBuilderNormalUnk4(commander->socialInfoId, replyMsg);
-    zoneBuilderNormalUnk5(replyMsg);
-
-    zoneBuilderStartGame(1.0, 0.0, 0.0, 0.0, replyMsg);
-    zoneBuilderObjectProperty(commander->socialInfoId, replyMsg);
-    // zoneBuilderStamina(replyMsg);
-    zoneBuilderLoginTime(replyMsg);
-
-    zoneBuilderMyPCEnter(&commander->pos, replyMsg);
-    // zoneBuilderSkillAdd(replyMsg);
+    // Shared packets come from the blob built at server start
+    zoneGameReadyBuildReply(commander, replyMsg);
 
     // Notify players around that a new PC has entered
     GameEventEnterPc pcEnterEvent = {
         .updatePosEvent = {
             .mapId = session->socket.mapId,
-            .commander = *commander
+            .pcId = commander->pcId,
+            .newPosition = commander->pos
         }
     };
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_ENTER_PC, &pcEnterEvent, sizeof(pcEnterEvent));
+    commanderAppearanceInit(&pcEnterEvent.appearance, commander);
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_ENTER_PC, &pcEnterEvent, sizeof(pcEnterEvent));
     // zoneBuilderEnterPc(&pcEnterEvent.updatePosEvent.info, replyMsg);
 
-    // zoneBuilderBuffList(commander->appearance.pcId, replyMsg);
-
-    // add NPC at the start screen
-    zoneBuilderEnterMonster(replyMsg);
-    zoneBuilderFaction(replyMsg);
-
     /*
     zoneBuilderNormalUnk6(
         commander->appearance.commanderName,
@@ -594,8 +560,6 @@ static PacketHandlerState zoneHandlerGameReady(
     zoneBuilderAddonMsg(replyMsg);
     */
 
-    zoneBuilderMoveSpeed(session->game.commanderSession.currentCommander->pcId, 31.0f, replyMsg);
-
     return PACKET_HANDLER_UPDATE_SESSION;
 }
 
@@ -680,6 +644,10 @@ static PacketHandlerState zoneHandlerConnect(
         goto cleanup;
     }
 
+    // Keep the previous map of the client, its EventServer shard may have to forget it
+    MapId_t fromMapId = session->socket.mapId;
+    Commander *fromCommander = session->game.commanderSession.currentCommander;
+
     // Update the Socket Session
     socketSessionInit(&session->socket,
         clientPacket->accountId,
@@ -706,6 +674,15 @@ static PacketHandlerState zoneHandlerConnect(
         goto cleanup;
     }
 
+    // Hand off the client to the EventServer shard of its new map, before any of its events on this map
+    if (fromMapId != (MapId_t) SOCKET_SESSION_UNDEFINED_MAP && fromCommander
+    && !(zoneEventServerDispatchWarp(self->eventServer, session->socket.sessionKey,
+            fromCommander->pcId, fromMapId, session->socket.mapId)))
+    {
+        error("Cannot hand off the client to the EventServer of the map %x.", session->socket.mapId);
+        goto cleanup;
+    }
+
     // Update the session
     session->game = tmpGameSession;
 
@@ -742,11 +719,12 @@ static PacketHandlerState zoneHandlerJump(
     GameEventJump event = {
         .updatePosEvent = {
             .mapId = session->socket.mapId,
-            .commander = *session->game.commanderSession.currentCommander
+            .pcId = session->game.commanderSession.currentCommander->pcId,
+            .newPosition = session->game.commanderSession.currentCommander->pos
         },
         .height = COMMANDER_HEIGHT_JUMP
     };
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_JUMP, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_JUMP, &event, sizeof(event));
 
     return PACKET_HANDLER_OK;
 }
@@ -793,7 +771,7 @@ static PacketHandlerState zoneHandlerHeadRotate(
         .direction = clientPacket->direction
     };
 
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_HEAD_ROTATE, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_HEAD_ROTATE, &event, sizeof(event));
 
     return PACKET_HANDLER_OK;
 }
@@ -819,7 +797,7 @@ static PacketHandlerState zoneHandlerRotate(
         .direction = clientPacket->direction
     };
 
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_ROTATE, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_ROTATE, &event, sizeof(event));
 
     return PACKET_HANDLER_OK;
 }
@@ -839,7 +817,7 @@ static PacketHandlerState zoneHandlerPose(
     } *clientPacket = (void *) packet;
     #pragma pack(pop)
 
-    CHECK_CLIENT_PACKET_SIZE(*clientPacket, packetSize, CZ_POSE);
+    CHECK_CLIENT_PACKET_SIZE_WAIVED(*clientPacket, packetSize, CZ_POSE);
 
     // notify the players around
     GameEventPose event = {
@@ -849,7 +827,7 @@ static PacketHandlerState zoneHandlerPose(
         .direction = clientPacket->direction
     };
 
-    workerDispatchEvent(self, session->socket.sessionKey, EVENT_TYPE_POSE, &event, sizeof(event));
+    workerDispatchEvent(self, session->socket.mapId, session->socket.sessionKey, EVENT_TYPE_POSE, &event, sizeof(event));
 
     return PACKET_HANDLER_OK;
 }
@@ -16,6 +16,7 @@
 
 #include "zone_server.h"
 #include "zone_handler/admin_cmd.h"
+#include "zone_handler/zone_game_ready.h"
 #include "common/server/server.h"
 #include "common/db/db.h"
 #include "common/actor/item/item_factory.h"
@@ -64,12 +65,6 @@ bool zoneServerInit(ZoneServer *self, Server *server) {
         error("Cannot allocate a dbSession.");
         return false;
     }
-
-    // Initialize packets manager
-    if (!(packetTypeInit())) {
-        error("Cannot initialize packet manager.");
-        return false;
-    }
 
     return true;
 }
@@ -98,6 +93,12 @@ bool zoneServerStart(ZoneServer *self) {
         return false;
     }
 
+    // Build the packets of the GAME_READY reply shared by every commander
+    if (!(zoneGameReadyInit())) {
+        error("Cannot initialize the GAME_READY reply.");
+        return false;
+    }
+
     if (!(serverStart(self->server))) {
         error("Cannot start the Server.");
         return false;
@@ -109,6 +110,7 @@ bool zoneServerStart(ZoneServer *self) {
 void zoneServerDestroy(ZoneServer **_self) {
     ZoneServer *self = *_self;
 
+    zoneGameReadyFree();
     free(self);
     *_self = NULL;
 }